@@ -0,0 +1,308 @@
+#pragma once
+
+#include <cmath>
+#include <complex>
+#include <functional>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/math/special_functions.hpp>
+#include <boost/multiprecision/cpp_bin_float.hpp>
+
+// Reference values are evaluated in 50 digit binary floating point and then rounded to long double, which still
+// leaves ~11 spare bits below the last double digit for measuring errors in ULPs.
+typedef boost::multiprecision::cpp_bin_float_50 ref_real;
+typedef std::function<ref_real(const ref_real &)> ref_fun;
+
+inline const std::unordered_map<std::string, ref_fun> &get_reference_funs() {
+    using namespace boost::math;
+    using boost::multiprecision::cos;
+    using boost::multiprecision::exp;
+    using boost::multiprecision::log;
+    using boost::multiprecision::pow;
+    using boost::multiprecision::sin;
+    using boost::multiprecision::sqrt;
+    const ref_real pi = constants::pi<ref_real>();
+
+    static const std::unordered_map<std::string, ref_fun> funs = {
+        {"copy", [](const ref_real &x) { return x; }},
+        {"sin", [](const ref_real &x) { return sin(x); }},
+        {"cos", [](const ref_real &x) { return cos(x); }},
+        {"tan", [](const ref_real &x) { return boost::multiprecision::tan(x); }},
+        {"sinh", [](const ref_real &x) { return boost::multiprecision::sinh(x); }},
+        {"cosh", [](const ref_real &x) { return boost::multiprecision::cosh(x); }},
+        {"tanh", [](const ref_real &x) { return boost::multiprecision::tanh(x); }},
+        {"asin", [](const ref_real &x) { return boost::multiprecision::asin(x); }},
+        {"acos", [](const ref_real &x) { return boost::multiprecision::acos(x); }},
+        {"atan", [](const ref_real &x) { return boost::multiprecision::atan(x); }},
+        {"asinh", [](const ref_real &x) { return asinh(x); }},
+        {"acosh", [](const ref_real &x) { return acosh(x); }},
+        {"atanh", [](const ref_real &x) { return atanh(x); }},
+        {"sin_pi", [](const ref_real &x) { return sin_pi(x); }},
+        {"cos_pi", [](const ref_real &x) { return cos_pi(x); }},
+        {"sinc", [](const ref_real &x) { return ref_real(sin(x) / x); }},
+        {"sinc_pi", [pi](const ref_real &x) { return ref_real(sin(pi * x) / (pi * x)); }},
+        {"exp", [](const ref_real &x) { return exp(x); }},
+        {"exp2", [](const ref_real &x) { return pow(ref_real(2), x); }},
+        {"exp10", [](const ref_real &x) { return pow(ref_real(10), x); }},
+        {"expm1", [](const ref_real &x) { return expm1(x); }},
+        {"log", [](const ref_real &x) { return log(x); }},
+        {"log2", [](const ref_real &x) { return ref_real(log(x) / constants::ln_two<ref_real>()); }},
+        {"log10", [](const ref_real &x) { return boost::multiprecision::log10(x); }},
+        {"sqrt", [](const ref_real &x) { return sqrt(x); }},
+        {"rsqrt", [](const ref_real &x) { return ref_real(1 / sqrt(x)); }},
+        {"pow3.5", [](const ref_real &x) { return pow(x, ref_real(3.5)); }},
+        {"pow13", [](const ref_real &x) { return pow(x, 13); }},
+        {"erf", [](const ref_real &x) { return erf(x); }},
+        {"erfc", [](const ref_real &x) { return erfc(x); }},
+        {"ndtri", [](const ref_real &x) { return ref_real(-constants::root_two<ref_real>() * erfc_inv(2 * x)); }},
+        {"tgamma", [](const ref_real &x) { return tgamma(x); }},
+        {"lgamma", [](const ref_real &x) { return lgamma(x); }},
+        {"digamma", [](const ref_real &x) { return digamma(x); }},
+        {"riemann_zeta", [](const ref_real &x) { return zeta(x); }},
+        {"bessel_J0", [](const ref_real &x) { return cyl_bessel_j(0, x); }},
+        {"bessel_J1", [](const ref_real &x) { return cyl_bessel_j(1, x); }},
+        {"bessel_J2", [](const ref_real &x) { return cyl_bessel_j(2, x); }},
+        {"bessel_Y0", [](const ref_real &x) { return cyl_neumann(0, x); }},
+        {"bessel_Y1", [](const ref_real &x) { return cyl_neumann(1, x); }},
+        {"bessel_Y2", [](const ref_real &x) { return cyl_neumann(2, x); }},
+        {"bessel_I0", [](const ref_real &x) { return cyl_bessel_i(0, x); }},
+        {"bessel_I1", [](const ref_real &x) { return cyl_bessel_i(1, x); }},
+        {"bessel_I2", [](const ref_real &x) { return cyl_bessel_i(2, x); }},
+        {"bessel_K0", [](const ref_real &x) { return cyl_bessel_k(0, x); }},
+        {"bessel_K1", [](const ref_real &x) { return cyl_bessel_k(1, x); }},
+        {"bessel_K2", [](const ref_real &x) { return cyl_bessel_k(2, x); }},
+        // boost::math::sinc_pi/sph_bessel do not instantiate for multiprecision types, so use the closed forms
+        {"bessel_j0", [](const ref_real &x) { return ref_real(sin(x) / x); }},
+        {"bessel_j1", [](const ref_real &x) { return ref_real(sin(x) / (x * x) - cos(x) / x); }},
+        {"bessel_j2",
+         [](const ref_real &x) { return ref_real((3 / (x * x) - 1) * sin(x) / x - 3 * cos(x) / (x * x)); }},
+        {"bessel_y0", [](const ref_real &x) { return ref_real(-cos(x) / x); }},
+        {"bessel_y1", [](const ref_real &x) { return ref_real(-cos(x) / (x * x) - sin(x) / x); }},
+        {"bessel_y2",
+         [](const ref_real &x) { return ref_real((1 - 3 / (x * x)) * cos(x) / x - 3 * sin(x) / (x * x)); }},
+        {"hermite_0", [](const ref_real &x) { return hermite(0, x); }},
+        {"hermite_1", [](const ref_real &x) { return hermite(1, x); }},
+        {"hermite_2", [](const ref_real &x) { return hermite(2, x); }},
+        {"hermite_3", [](const ref_real &x) { return hermite(3, x); }},
+    };
+    return funs;
+}
+
+// Two-argument functions, see multi_eval_func2. Bessel orders are the second argument truncated toward zero.
+typedef std::function<ref_real(const ref_real &, const ref_real &)> ref_fun2;
+
+inline const std::unordered_map<std::string, ref_fun2> &get_reference_funs2() {
+    using namespace boost::math;
+    using boost::multiprecision::atan2;
+    using boost::multiprecision::fmod;
+    using boost::multiprecision::pow;
+    using boost::multiprecision::sqrt;
+    auto order = [](const ref_real &y) { return int(y.convert_to<double>()); };
+
+    static const std::unordered_map<std::string, ref_fun2> funs = {
+        {"pow", [](const ref_real &x, const ref_real &y) { return ref_real(pow(x, y)); }},
+        {"atan2", [](const ref_real &x, const ref_real &y) { return ref_real(atan2(x, y)); }},
+        {"hypot", [](const ref_real &x, const ref_real &y) { return ref_real(sqrt(x * x + y * y)); }},
+        {"fmod", [](const ref_real &x, const ref_real &y) { return ref_real(fmod(x, y)); }},
+        {"bessel_Jn", [order](const ref_real &x, const ref_real &y) { return cyl_bessel_j(order(y), x); }},
+        {"bessel_Kn", [order](const ref_real &x, const ref_real &y) { return cyl_bessel_k(order(y), x); }},
+    };
+    return funs;
+}
+
+// Complex functions of one complex argument, as (real, imaginary) parts of the result from those of the argument.
+// Only the closed forms: GSL's dilog and lgamma (whose phase it reduces to (-pi, pi]) have no reference.
+typedef std::function<std::pair<ref_real, ref_real>(const ref_real &, const ref_real &)> ref_cfun;
+
+inline const std::unordered_map<std::string, ref_cfun> &get_reference_cfuns() {
+    using boost::multiprecision::atan2;
+    using boost::multiprecision::cos;
+    using boost::multiprecision::cosh;
+    using boost::multiprecision::log;
+    using boost::multiprecision::sin;
+    using boost::multiprecision::sinh;
+
+    static const std::unordered_map<std::string, ref_cfun> funs = {
+        {"sin",
+         [](const ref_real &x, const ref_real &y) {
+             return std::pair{ref_real(sin(x) * cosh(y)), ref_real(cos(x) * sinh(y))};
+         }},
+        {"cos",
+         [](const ref_real &x, const ref_real &y) {
+             return std::pair{ref_real(cos(x) * cosh(y)), ref_real(-sin(x) * sinh(y))};
+         }},
+        {"log",
+         [](const ref_real &x, const ref_real &y) {
+             return std::pair{ref_real(log(x * x + y * y) / 2), ref_real(atan2(y, x))};
+         }},
+    };
+    return funs;
+}
+
+class ErrorStats {
+  public:
+    std::size_t n_samples = 0;
+    double max_ulp = 0.0;
+    double rms_ulp = 0.0;
+    double max_rel = 0.0;
+    double rms_rel = 0.0;
+    double max_abs = 0.0;
+};
+
+// Reference values of function `name` at x, or nullptr if no reference exists. The last set of inputs per function
+// and type is cached, since every library entry for a given key sees the same inputs.
+template <typename VAL_T>
+const std::vector<long double> *reference_eval(const std::string &name, const std::vector<VAL_T> &x) {
+    static std::unordered_map<std::string, std::pair<std::vector<VAL_T>, std::vector<long double>>> cache;
+
+    const auto &ref_funs = get_reference_funs();
+    if (!ref_funs.count(name))
+        return nullptr;
+
+    auto &[x_cached, ref] = cache[name];
+    if (x_cached == x)
+        return &ref;
+
+    const ref_fun &f = ref_funs.at(name);
+    x_cached = x;
+    ref.resize(x.size());
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        try {
+            ref[i] = f(ref_real(x[i])).template convert_to<long double>();
+        } catch (const std::exception &) {
+            ref[i] = std::numeric_limits<long double>::quiet_NaN();
+        }
+    }
+
+    return &ref;
+}
+
+// reference_eval for the two-argument functions
+template <typename VAL_T>
+const std::vector<long double> *reference_eval2(const std::string &name, const std::vector<VAL_T> &x,
+                                                const std::vector<VAL_T> &y) {
+    static std::unordered_map<std::string, std::pair<std::vector<VAL_T>, std::vector<long double>>> cache;
+
+    const auto &ref_funs = get_reference_funs2();
+    if (!ref_funs.count(name))
+        return nullptr;
+
+    std::vector<VAL_T> xy = x;
+    xy.insert(xy.end(), y.begin(), y.end());
+    auto &[xy_cached, ref] = cache[name];
+    if (xy_cached == xy)
+        return &ref;
+
+    const ref_fun2 &f = ref_funs.at(name);
+    xy_cached = xy;
+    ref.resize(x.size());
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        try {
+            ref[i] = f(ref_real(x[i]), ref_real(y[i])).template convert_to<long double>();
+        } catch (const std::exception &) {
+            ref[i] = std::numeric_limits<long double>::quiet_NaN();
+        }
+    }
+
+    return &ref;
+}
+
+// reference_eval for the complex functions, rounded to the precision of the results
+template <typename VAL_T>
+const std::vector<std::complex<VAL_T>> *reference_evalc(const std::string &name,
+                                                        const std::vector<std::complex<VAL_T>> &z) {
+    typedef std::vector<std::complex<VAL_T>> values;
+    static std::unordered_map<std::string, std::pair<values, values>> cache;
+
+    const auto &ref_funs = get_reference_cfuns();
+    if (!ref_funs.count(name))
+        return nullptr;
+
+    auto &[z_cached, ref] = cache[name];
+    if (z_cached == z)
+        return &ref;
+
+    const ref_cfun &f = ref_funs.at(name);
+    z_cached = z;
+    ref.resize(z.size());
+    for (std::size_t i = 0; i < z.size(); ++i) {
+        try {
+            const auto [re, im] = f(ref_real(z[i].real()), ref_real(z[i].imag()));
+            ref[i] = {re.template convert_to<VAL_T>(), im.template convert_to<VAL_T>()};
+        } catch (const std::exception &) {
+            ref[i] = {std::numeric_limits<VAL_T>::quiet_NaN(), std::numeric_limits<VAL_T>::quiet_NaN()};
+        }
+    }
+
+    return &ref;
+}
+
+// Error of `res` against `ref` in units in the last place of VAL_T, and relative error. Points where the reference is
+// undefined or outside the range of VAL_T are skipped; a non-finite result where the reference is finite counts as an
+// infinite error.
+template <typename VAL_T>
+ErrorStats error_stats(const std::vector<VAL_T> &res, const std::vector<long double> &ref) {
+    ErrorStats stats;
+    for (std::size_t i = 0; i < res.size(); ++i) {
+        if (!std::isfinite(ref[i]))
+            continue;
+
+        const VAL_T ref_t = static_cast<VAL_T>(ref[i]);
+        if (!std::isfinite(ref_t))
+            continue;
+        const long double ulp = std::max<long double>(
+            std::abs(std::nextafter(ref_t, std::numeric_limits<VAL_T>::infinity()) - ref_t),
+            std::numeric_limits<VAL_T>::denorm_min());
+        const long double abs_err = std::abs(static_cast<long double>(res[i]) - ref[i]);
+        const double ulp_err = std::isfinite(res[i]) ? abs_err / ulp : std::numeric_limits<double>::infinity();
+        const double rel_err = std::isfinite(res[i]) ? (ref[i] == 0.0 ? abs_err : abs_err / std::abs(ref[i]))
+                                                     : std::numeric_limits<double>::infinity();
+
+        stats.n_samples++;
+        stats.max_ulp = std::max(stats.max_ulp, ulp_err);
+        stats.max_rel = std::max(stats.max_rel, rel_err);
+        stats.max_abs = std::max(stats.max_abs, std::isfinite(res[i]) ? double(abs_err)
+                                                                       : std::numeric_limits<double>::infinity());
+        stats.rms_ulp += ulp_err * ulp_err;
+        stats.rms_rel += rel_err * rel_err;
+    }
+
+    if (stats.n_samples) {
+        stats.rms_ulp = std::sqrt(stats.rms_ulp / stats.n_samples);
+        stats.rms_rel = std::sqrt(stats.rms_rel / stats.n_samples);
+    }
+    return stats;
+}
+
+// Error of complex results against a complex reference of the same precision. The ULP columns hold the relative error
+// |res - ref| / |ref| in units of the machine epsilon, since there is no ULP of a complex number.
+template <typename VAL_T>
+ErrorStats error_stats(const std::vector<std::complex<VAL_T>> &res, const std::vector<std::complex<VAL_T>> &ref) {
+    ErrorStats stats;
+    for (std::size_t i = 0; i < res.size(); ++i) {
+        if (!std::isfinite(std::abs(ref[i])))
+            continue;
+
+        const double abs_err = std::isfinite(std::abs(res[i])) ? std::abs(res[i] - ref[i])
+                                                               : std::numeric_limits<double>::infinity();
+        const double rel_err = ref[i] == std::complex<VAL_T>(0) ? abs_err : abs_err / std::abs(ref[i]);
+        const double ulp_err = rel_err / std::numeric_limits<VAL_T>::epsilon();
+
+        stats.n_samples++;
+        stats.max_ulp = std::max(stats.max_ulp, ulp_err);
+        stats.max_rel = std::max(stats.max_rel, rel_err);
+        stats.max_abs = std::max(stats.max_abs, abs_err);
+        stats.rms_ulp += ulp_err * ulp_err;
+        stats.rms_rel += rel_err * rel_err;
+    }
+
+    if (stats.n_samples) {
+        stats.rms_ulp = std::sqrt(stats.rms_ulp / stats.n_samples);
+        stats.rms_rel = std::sqrt(stats.rms_rel / stats.n_samples);
+    }
+    return stats;
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// An mmapped region, unmapped when it goes out of scope
+class MappedRegion {
+  public:
+    MappedRegion() = default;
+    MappedRegion(void *addr, std::size_t size) : addr_(addr), size_(size) {}
+    ~MappedRegion() {
+        if (addr_)
+            munmap(addr_, size_);
+    }
+
+    MappedRegion(MappedRegion &&other) noexcept
+        : addr_(std::exchange(other.addr_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+    MappedRegion &operator=(MappedRegion &&other) noexcept {
+        std::swap(addr_, other.addr_);
+        std::swap(size_, other.size_);
+        return *this;
+    }
+    MappedRegion(const MappedRegion &) = delete;
+    MappedRegion &operator=(const MappedRegion &) = delete;
+
+    void *data() const { return addr_; }
+    std::size_t size() const { return size_; }
+
+    // Whole file, read-only. MAP_POPULATE reads it into the page cache up front, so replaying it doesn't fault on
+    // the disk in the timed passes.
+    static MappedRegion map_file(const std::string &fname) {
+        const int fd = open(fname.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("Can't open " + fname + ": " + std::strerror(errno));
+        struct stat st;
+        fstat(fd, &st);
+        void *addr = st.st_size ? mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0) : MAP_FAILED;
+        close(fd);
+        if (addr == MAP_FAILED)
+            throw std::runtime_error("Can't map " + fname + ": " + std::strerror(errno));
+        return MappedRegion(addr, st.st_size);
+    }
+
+    // Read-write memory of at least `size` bytes, with every page faulted in. `backing` is "hugetlb" (explicit huge
+    // pages, falling back to "thp" if none are reserved), "thp" (transparent huge pages) or the name of a file to map.
+    static MappedRegion allocate(std::size_t size, const std::string &backing) {
+        const std::size_t huge_page = 2 << 20;
+        size = (size + huge_page - 1) / huge_page * huge_page;
+
+        const int anon = MAP_PRIVATE | MAP_ANONYMOUS;
+        void *addr = MAP_FAILED;
+        if (backing == "hugetlb") {
+            addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, anon | MAP_HUGETLB, -1, 0);
+            if (addr == MAP_FAILED)
+                std::cerr << "MAP_HUGETLB failed: " << std::strerror(errno)
+                          << " (check /proc/sys/vm/nr_hugepages), using transparent huge pages\n";
+        }
+        if (addr == MAP_FAILED && (backing == "hugetlb" || backing == "thp")) {
+            addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, anon, -1, 0);
+            if (addr != MAP_FAILED)
+                madvise(addr, size, MADV_HUGEPAGE);
+        } else if (addr == MAP_FAILED) {
+            const int fd = open(backing.c_str(), O_RDWR | O_CREAT, 0644);
+            if (fd < 0 || ftruncate(fd, size) != 0)
+                throw std::runtime_error("Can't create " + backing + ": " + std::strerror(errno));
+            addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            close(fd);
+        }
+        if (addr == MAP_FAILED)
+            throw std::runtime_error("Can't allocate " + std::to_string(size) + " bytes: " + std::strerror(errno));
+
+        std::memset(addr, 0, size);
+        return MappedRegion(addr, size);
+    }
+
+  private:
+    void *addr_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+// Input and result buffers shared by every entry in place of per-entry allocations. They are faulted in once, up
+// front, so neither page faults nor first touch end up in the timed passes, and stay at the same addresses across
+// entries.
+class Arena {
+  public:
+    Arena(std::size_t input_bytes, std::size_t output_bytes, const std::string &backing)
+        : input_bytes_(align(input_bytes)), region_(MappedRegion::allocate(input_bytes_ + output_bytes, backing)) {}
+
+    template <typename T>
+    T *input() const {
+        return static_cast<T *>(region_.data());
+    }
+
+    template <typename T>
+    T *output() const {
+        return reinterpret_cast<T *>(static_cast<char *>(region_.data()) + input_bytes_);
+    }
+
+    bool fits(std::size_t input_bytes, std::size_t output_bytes) const {
+        return input_bytes <= input_bytes_ && output_bytes <= region_.size() - input_bytes_;
+    }
+
+    std::size_t size() const { return region_.size(); }
+
+  private:
+    std::size_t input_bytes_;
+    MappedRegion region_;
+
+    static std::size_t align(std::size_t bytes) { return (bytes + 4095) / 4096 * 4096; }
+};
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <optional>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+// The entries of one --csv file, by label, input length, thread count and mode, and its metadata lines. Columns are
+// found by name, so files with fewer or more columns than this build writes still load.
+class ResultFile {
+  public:
+    class Row {
+      public:
+        double Mevals = 0.0;
+        double eval_time = 0.0; // median of the samples
+        int n_samples = 1;
+        double t_stddev = NAN; // of the samples, NaN for a single one
+        std::optional<double> max_ulp;
+    };
+    typedef std::tuple<std::string, std::size_t, int, std::string> Key;
+
+    std::string fname;
+    std::map<Key, Row> rows;
+    std::map<std::string, std::string> metadata;
+
+    explicit ResultFile(const std::string &fname_) : fname(fname_) {
+        std::ifstream f(fname);
+        if (!f)
+            throw std::runtime_error("Can't open " + fname);
+
+        std::string line;
+        std::unordered_map<std::string, std::size_t> column;
+        while (std::getline(f, line)) {
+            if (line.rfind("# ", 0) == 0) {
+                const std::size_t colon = line.find(": ");
+                if (colon != std::string::npos)
+                    metadata[line.substr(2, colon - 2)] = line.substr(colon + 2);
+                continue;
+            }
+            const std::vector<std::string> fields = split(line);
+            if (column.empty()) {
+                for (std::size_t i = 0; i < fields.size(); ++i)
+                    column[fields[i]] = i;
+                for (const char *name : {"label", "n_eval", "n_threads", "mode", "eval_time", "Mevals"})
+                    if (!column.count(name))
+                        throw std::runtime_error(fname + " has no '" + name + "' column, expected --csv output");
+                continue;
+            }
+
+            const auto field = [&](const std::string &name) -> std::string {
+                return column.count(name) && column[name] < fields.size() ? fields[column[name]] : "";
+            };
+            const auto number = [&](const std::string &name) -> std::optional<double> {
+                const std::string value = field(name);
+                return value.empty() ? std::nullopt : std::optional<double>(std::stod(value));
+            };
+            Row row;
+            row.Mevals = number("Mevals").value_or(0.0);
+            row.eval_time = number("eval_time").value_or(0.0);
+            row.n_samples = int(number("n_samples").value_or(1));
+            row.t_stddev = number("t_stddev").value_or(NAN);
+            row.max_ulp = number("max_ulp");
+            rows[{field("label"), std::stoul(field("n_eval")), std::stoi(field("n_threads")), field("mode")}] = row;
+        }
+        if (column.empty())
+            throw std::runtime_error(fname + " has no header line, expected --csv output");
+    }
+
+  private:
+    static std::vector<std::string> split(const std::string &line) {
+        std::vector<std::string> res;
+        std::stringstream ss(line);
+        std::string field;
+        while (std::getline(ss, field, ','))
+            res.push_back(field);
+        if (!line.empty() && line.back() == ',')
+            res.push_back("");
+        return res;
+    }
+};
+
+// Two-sided 95 % quantile of Student's t with df degrees of freedom. Past the table 1.96 + 2.4 / df is within 0.01.
+inline double t_quantile_95(double df) {
+    static const double table[] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                   2.201,  2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086};
+    const int n = sizeof(table) / sizeof(table[0]);
+    if (df < 1)
+        return table[0];
+    return df <= n ? table[int(df) - 1] : 1.96 + 2.4 / df;
+}
+
+// Change of one entry from an old to a new run
+class ResultChange {
+  public:
+    double change = 0.0;              // Mevals/s new over old, minus 1
+    std::optional<double> half_width; // of the 95 % confidence interval of change, if both runs took several samples
+    bool slower = false;              // change is below -threshold and so is its whole confidence interval
+    bool less_accurate = false;       // max ULP error grew by more than the ULP threshold
+
+    // Rates rather than times: the key leaves out the repeat count, and eval_time covers all of them. The sample
+    // times give the relative error of each median: about 1.25 times the standard error of a mean, combined with
+    // Welch's degrees of freedom.
+    ResultChange(const ResultFile::Row &old_row, const ResultFile::Row &new_row, double threshold,
+                 double ulp_threshold) {
+        change = new_row.Mevals / old_row.Mevals - 1;
+        if (old_row.n_samples > 1 && new_row.n_samples > 1 && std::isfinite(old_row.t_stddev) &&
+            std::isfinite(new_row.t_stddev)) {
+            const double a = std::pow(1.2533 * old_row.t_stddev / old_row.eval_time, 2) / old_row.n_samples;
+            const double b = std::pow(1.2533 * new_row.t_stddev / new_row.eval_time, 2) / new_row.n_samples;
+            const double welch = a * a / (old_row.n_samples - 1) + b * b / (new_row.n_samples - 1);
+            const double df = welch > 0 ? (a + b) * (a + b) / welch : old_row.n_samples + new_row.n_samples - 2;
+            half_width = t_quantile_95(df) * (1 + change) * std::sqrt(a + b);
+        }
+        slower = change < -threshold && (!half_width || change + *half_width < 0);
+        less_accurate = old_row.max_ulp && new_row.max_ulp && *new_row.max_ulp > *old_row.max_ulp + ulp_threshold;
+    }
+};
+
+// Every entry of `new_file` that is also in `old_file`, with its change in Mevals/s and max ULP error, the metadata
+// that differs (library versions, flags) and the entries only one of them has. Returns the number of entries that
+// got slower or less accurate.
+inline int compare_results(std::ostream &os, const ResultFile &old_file, const ResultFile &new_file, double threshold,
+                           double ulp_threshold) {
+    using std::left;
+    using std::setw;
+    const auto entry_name = [](const ResultFile::Key &key) {
+        return std::get<0>(key) + (std::get<3>(key) == "latency" ? " (latency)" : "");
+    };
+    for (const auto &[key, value] : new_file.metadata)
+        if (old_file.metadata.count(key) && old_file.metadata.at(key) != value && key != "date")
+            os << key << ": " << old_file.metadata.at(key) << " -> " << value << "\n";
+
+    os << left << setw(30) << "label" << setw(10) << "N" << setw(8) << "threads" << setw(12) << "old Mevals"
+       << setw(12) << "new Mevals" << setw(10) << "change" << setw(10) << "+-95%" << "max_ulp\n";
+    int n_matched = 0, n_slower = 0, n_less_accurate = 0;
+    std::vector<std::string> only_old, only_new;
+    for (const auto &[key, old_row] : old_file.rows) {
+        const auto &[label, n_eval, n_threads, mode] = key;
+        const std::string name = entry_name(key);
+        if (!new_file.rows.count(key)) {
+            only_old.push_back(name + " N=" + std::to_string(n_eval));
+            continue;
+        }
+        const ResultFile::Row &new_row = new_file.rows.at(key);
+        const ResultChange res(old_row, new_row, threshold, ulp_threshold);
+        n_matched++;
+        n_slower += res.slower;
+        n_less_accurate += res.less_accurate;
+
+        std::ostringstream change, half_width, ulp;
+        change << std::showpos << std::fixed << std::setprecision(1) << 100 * res.change << "%";
+        if (res.half_width)
+            half_width << std::fixed << std::setprecision(1) << 100 * *res.half_width << "%";
+        else
+            half_width << "-";
+        if (old_row.max_ulp || new_row.max_ulp)
+            ulp << std::setprecision(3) << (old_row.max_ulp ? *old_row.max_ulp : NAN) << " -> "
+                << (new_row.max_ulp ? *new_row.max_ulp : NAN);
+        os << left << setw(30) << name << setw(10) << n_eval << setw(8) << n_threads << std::setprecision(6) << setw(12)
+           << old_row.Mevals << setw(12) << new_row.Mevals << setw(10) << change.str() << setw(10) << half_width.str()
+           << setw(20) << ulp.str() << (res.slower ? " SLOWER" : "") << (res.less_accurate ? " LESS ACCURATE" : "")
+           << "\n";
+    }
+    for (const auto &[key, new_row] : new_file.rows)
+        if (!old_file.rows.count(key))
+            only_new.push_back(entry_name(key) + " N=" + std::to_string(std::get<1>(key)));
+
+    for (const auto &[names, fname] : {std::pair{&only_old, &old_file.fname}, std::pair{&only_new, &new_file.fname}})
+        if (!names->empty()) {
+            os << "Only in " << *fname << ":";
+            for (const auto &name : *names)
+                os << " " << name;
+            os << "\n";
+        }
+    os << n_matched << " entries compared, " << n_slower << " slower by more than " << 100 * threshold << "%, "
+       << n_less_accurate << " with max_ulp up by more than " << ulp_threshold << "\n";
+    return n_slower + n_less_accurate;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+#include <string>
+
+// Library, precision and lane count encoded in an entry's library prefix, e.g. sleef_dx8 -> sleef, d, 8
+class EntrySpec {
+  public:
+    std::string library;
+    std::string precision; // "f", "d" or "cd"
+    int width = 0;         // 0 when unspecified, e.g. eigen_dxx
+
+    // <library>_<precision>x<width>, where the width is a lane count or "x". Throws on anything else, so that a
+    // misspelled prefix can't pass for an entry of unspecified width.
+    EntrySpec(const std::string &library_prefix) {
+        const std::size_t split = library_prefix.rfind('_');
+        const std::string spec = split == std::string::npos ? "" : library_prefix.substr(split + 1);
+        const std::size_t x = spec.find('x');
+        library = library_prefix.substr(0, split);
+        precision = spec.substr(0, x);
+        const std::string lanes = x == std::string::npos ? "" : spec.substr(x + 1);
+        const bool valid_width =
+            lanes == "x" || (!lanes.empty() && lanes.size() <= 4 && lanes[0] != '0' &&
+                             std::all_of(lanes.begin(), lanes.end(), [](unsigned char c) { return std::isdigit(c); }));
+        if (library.empty() || (precision != "f" && precision != "d" && precision != "cd") || !valid_width)
+            throw std::invalid_argument("Entry prefix '" + library_prefix +
+                                        "' is not <library>_<f|d|cd>x<width|x>, e.g. sleef_dx8");
+        if (lanes != "x")
+            width = std::stoi(lanes);
+    }
+
+    // Library that a variant entry, e.g. "-inline", mirrors, otherwise the library itself
+    std::string base_library() const { return library.substr(0, library.find('-')); }
+
+    // e.g. "inline" or "separate", empty for the library's own entries
+    std::string variant() const {
+        const std::size_t dash = library.find('-');
+        return dash == std::string::npos ? "" : library.substr(dash + 1);
+    }
+};
@@ -0,0 +1,385 @@
+#pragma once
+
+// Vectorized port of hank103 (src/hank103.f) for arguments in the closed upper half plane, evaluated in split real /
+// imaginary (SoA) layout. Like vec_apply.hpp this is included by the per-ISA kernel translation units only.
+#if !defined(VCL_NAMESPACE)
+#error "Define VCL_NAMESPACE before including hank103_vec.hpp"
+#endif
+
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <limits>
+
+#include <vectorclass.h>
+#include <vectormath_exp.h>
+#include <vectormath_trig.h>
+
+#include "kernels.hpp"
+
+namespace hank103_vec {
+// hank103u expansions in 1/sqrt(z) as (re, im) pairs: *p1 for 1 <= |z|^2 <= 3.7^2, *p2 for 3.7^2 < |z|^2 <= 20^2.
+// The Fortran splits each table over two data statements joined by an equivalence.
+inline constexpr double u_c0p1[70] = {
+    -.6619836118357782E-12, -.6619836118612709E-12, -.7307514264754200E-21, 0.3928160926261892E-10,
+    0.5712712520172854E-09, -.5712712519967086E-09, -.1083820384008718E-07, -.1894529309455499E-18,
+    0.7528123700585197E-07, 0.7528123700841491E-07, 0.1356544045548053E-16, -.8147940452202855E-06,
+    -.3568198575016769E-05, 0.3568198574899888E-05, 0.2592083111345422E-04, 0.4209074870019400E-15,
+    -.7935843289157352E-04, -.7935843289415642E-04, -.6848330800445365E-14, 0.4136028298630129E-03,
+    0.9210433149997867E-03, -.9210433149680665E-03, -.3495306809056563E-02, -.6469844672213905E-13,
+    0.5573890502766937E-02, 0.5573890503000873E-02, 0.3767341857978150E-12, -.1439178509436339E-01,
+    -.1342403524448708E-01, 0.1342403524340215E-01, 0.8733016209933828E-02, 0.1400653553627576E-11,
+    0.2987361261932706E-01, 0.2987361261607835E-01, -.3388096836339433E-11, -.1690673895793793E+00,
+    0.2838366762606121E+00, -.2838366762542546E+00, 0.7045107746587499E+00, -.5363893133864181E-11,
+    -.7788044738211666E+00, -.7788044738130360E+00, 0.5524779104964783E-11, 0.1146003459721775E+01,
+    0.6930697486173089E+00, -.6930697486240221E+00, -.7218270272305891E+00, 0.3633022466839301E-11,
+    0.3280924142354455E+00, 0.3280924142319602E+00, -.1472323059106612E-11, -.2608421334424268E+00,
+    -.9031397649230536E-01, 0.9031397649339185E-01, 0.5401342784296321E-01, -.3464095071668884E-12,
+    -.1377057052946721E-01, -.1377057052927901E-01, 0.4273263742980154E-13, 0.5877224130705015E-02,
+    0.1022508471962664E-02, -.1022508471978459E-02, -.2789107903871137E-03, 0.2283984571396129E-14,
+    0.2799719727019427E-04, 0.2799719726970900E-04, -.3371218242141487E-16, -.3682310515545645E-05,
+    -.1191412910090512E-06, 0.1191412910113518E-06
+};
+
+inline constexpr double u_c1p1[70] = {
+    0.4428361927253983E-12, -.4428361927153559E-12, -.2575693161635231E-10, -.2878656317479645E-21,
+    0.3658696304107867E-09, 0.3658696304188925E-09, 0.7463138750413651E-19, -.6748894854135266E-08,
+    -.4530098210372099E-07, 0.4530098210271137E-07, 0.4698787882823243E-06, 0.5343848349451927E-17,
+    -.1948662942158171E-05, -.1948662942204214E-05, -.1658085463182409E-15, 0.1316906100496570E-04,
+    0.3645368564036497E-04, -.3645368563934748E-04, -.1633458547818390E-03, -.2697770638600506E-14,
+    0.2816784976551660E-03, 0.2816784976676616E-03, 0.2548673351180060E-13, -.6106478245116582E-03,
+    0.2054057459296899E-03, -.2054057460218446E-03, -.6254962367291260E-02, 0.1484073406594994E-12,
+    0.1952900562500057E-01, 0.1952900562457318E-01, -.5517611343746895E-12, -.8528074392467523E-01,
+    -.1495138141086974E+00, 0.1495138141099772E+00, 0.4394907314508377E+00, -.1334677126491326E-11,
+    -.1113740586940341E+01, -.1113740586937837E+01, 0.2113005088866033E-11, 0.1170212831401968E+01,
+    0.1262152242318805E+01, -.1262152242322008E+01, -.1557810619605511E+01, 0.2176383208521897E-11,
+    0.8560741701626648E+00, 0.8560741701600203E+00, -.1431161194996653E-11, -.8386735092525187E+00,
+    -.3651819176599290E+00, 0.3651819176613019E+00, 0.2811692367666517E+00, -.5799941348040361E-12,
+    -.9494630182937280E-01, -.9494630182894480E-01, 0.1364615527772751E-12, 0.5564896498129176E-01,
+    0.1395239688792536E-01, -.1395239688799950E-01, -.5871314703753967E-02, 0.1683372473682212E-13,
+    0.1009157100083457E-02, 0.1009157100077235E-02, -.8997331160162008E-15, -.2723724213360371E-03,
+    -.2708696587599713E-04, 0.2708696587618830E-04, 0.3533092798326666E-05, -.1328028586935163E-16,
+    -.1134616446885126E-06, -.1134616446876064E-06
+};
+
+inline constexpr double u_c0p2[62] = {
+    0.5641895835516786E+00, -.5641895835516010E+00, -.3902447089770041E-09, -.3334441074447365E-11,
+    -.7052368835911731E-01, -.7052368821797083E-01, 0.1957299315085370E-08, -.3126801711815631E-06,
+    -.3967331737107949E-01, 0.3967327747706934E-01, 0.6902866639752817E-04, 0.3178420816292497E-06,
+    0.4080457166061280E-01, 0.4080045784614144E-01, -.2218731025620065E-04, 0.6518438331871517E-02,
+    0.9798339748600499E-01, -.9778028374972253E-01, -.3151825524811773E+00, -.7995603166188139E-03,
+    0.1111323666639636E+01, 0.1116791178994330E+01, 0.1635711249533488E-01, -.8527067497983841E+01,
+    -.2595553689471247E+02, 0.2586942834408207E+02, 0.1345583522428299E+03, 0.2002017907999571E+00,
+    -.3086364384881525E+03, -.3094609382885628E+03, -.1505974589617013E+01, 0.1250150715797207E+04,
+    0.2205210257679573E+04, -.2200328091885836E+04, -.6724941072552172E+04, -.7018887749450317E+01,
+    0.8873498980910335E+04, 0.8891369384353965E+04, 0.2008805099643591E+02, -.2030681426035686E+05,
+    -.2010017782384992E+05, 0.2006046282661137E+05, 0.3427941581102808E+05, 0.3432892927181724E+02,
+    -.2511417407338804E+05, -.2516567363193558E+05, -.3318253740485142E+02, 0.3143940826027085E+05,
+    0.1658466564673543E+05, -.1654843151976437E+05, -.1446345041326510E+05, -.1645433213663233E+02,
+    0.5094709396573681E+04, 0.5106816671258367E+04, 0.3470692471612145E+01, -.2797902324245621E+04,
+    -.5615581955514127E+03, 0.5601021281020627E+03, 0.1463856702925587E+03, 0.1990076422327786E+00,
+    -.9334741618922085E+01, -.9361368967669095E+01
+};
+
+inline constexpr double u_c1p2[62] = {
+    -.5641895835446003E+00, -.5641895835437973E+00, 0.3473016376419171E-10, -.3710264617214559E-09,
+    0.2115710836381847E+00, -.2115710851180242E+00, 0.3132928887334847E-06, 0.2064187785625558E-07,
+    -.6611954881267806E-01, -.6611997176900310E-01, -.3386004893181560E-05, 0.7146557892862998E-04,
+    -.5728505088320786E-01, 0.5732906930408979E-01, -.6884187195973806E-02, -.2383737409286457E-03,
+    0.1170452203794729E+00, 0.1192356405185651E+00, 0.8652871239920498E-02, -.3366165876561572E+00,
+    -.1203989383538728E+01, 0.1144625888281483E+01, 0.9153684260534125E+01, 0.1781426600949249E+00,
+    -.2740411284066946E+02, -.2834461441294877E+02, -.2192611071606340E+01, 0.1445470231392735E+03,
+    0.3361116314072906E+03, -.3270584743216529E+03, -.1339254798224146E+04, -.1657618537130453E+02,
+    0.2327097844591252E+04, 0.2380960024514808E+04, 0.7760611776965994E+02, -.7162513471480693E+04,
+    -.9520608696419367E+04, 0.9322604506839242E+04, 0.2144033447577134E+05, 0.2230232555182369E+03,
+    -.2087584364240919E+05, -.2131762020653283E+05, -.3825699231499171E+03, 0.3582976792594737E+05,
+    0.2642632405857713E+05, -.2585137938787267E+05, -.3251446505037506E+05, -.3710875194432116E+03,
+    0.1683805377643986E+05, 0.1724393921722052E+05, 0.1846128226280221E+03, -.1479735877145448E+05,
+    -.5258288893282565E+04, 0.5122237462705988E+04, 0.2831540486197358E+04, 0.3905972651440027E+02,
+    -.5562781548969544E+03, -.5726891190727206E+03, -.2246192560136119E+01, 0.1465347141877978E+03,
+    0.9456733342595993E+01, -.9155767836700837E+01
+};
+
+// hank103a asymptotic series in 1/z^2, |z|^2 > 20^2. The Fortran tables have 18 terms of which only the first 10 are
+// used.
+inline constexpr double a_p[10] = {
+    0.1000000000000000E+01, -.7031250000000000E-01, 0.1121520996093750E+00, -.5725014209747314E+00,
+    0.6074042001273483E+01, -.1100171402692467E+03, 0.3038090510922384E+04, -.1188384262567833E+06,
+    0.6252951493434797E+07, -.4259392165047669E+09
+};
+
+inline constexpr double a_q[10] = {
+    -.1250000000000000E+00, 0.7324218750000000E-01, -.2271080017089844E+00, 0.1727727502584457E+01,
+    -.2438052969955606E+02, 0.5513358961220206E+03, -.1825775547429317E+05, 0.8328593040162893E+06,
+    -.5006958953198893E+08, 0.3836255180230434E+10
+};
+
+inline constexpr double a_p1[10] = {
+    0.1000000000000000E+01, 0.1171875000000000E+00, -.1441955566406250E+00, 0.6765925884246826E+00,
+    -.6883914268109947E+01, 0.1215978918765359E+03, -.3302272294480852E+04, 0.1276412726461746E+06,
+    -.6656367718817687E+07, 0.4502786003050393E+09
+};
+
+inline constexpr double a_q1[10] = {
+    0.3750000000000000E+00, -.1025390625000000E+00, 0.2775764465332031E+00, -.1993531733751297E+01,
+    0.2724882731126854E+02, -.6038440767050702E+03, 0.1971837591223663E+05, -.8902978767070679E+06,
+    0.5310411010968522E+08, -.4043620325107754E+10
+};
+
+// hank103l power series of J0, J1 and the non-logarithmic parts of Y0, Y1 in z^2, |z|^2 < 1
+inline constexpr double l_cj0[16] = {
+    0.1000000000000000E+01, -.2500000000000000E+00, 0.1562500000000000E-01, -.4340277777777778E-03,
+    0.6781684027777778E-05, -.6781684027777778E-07, 0.4709502797067901E-09, -.2402807549524439E-11,
+    0.9385966990329841E-14, -.2896903392077112E-16, 0.7242258480192779E-19, -.1496334396734045E-21,
+    0.2597802772107717E-24, -.3842903509035085E-27, 0.4901662639075363E-30, -.5446291821194848E-33
+};
+
+inline constexpr double l_cj1[16] = {
+    -.5000000000000000E+00, 0.6250000000000000E-01, -.2604166666666667E-02, 0.5425347222222222E-04,
+    -.6781684027777778E-06, 0.5651403356481481E-08, -.3363930569334215E-10, 0.1501754718452775E-12,
+    -.5214426105738801E-15, 0.1448451696038556E-17, -.3291935672814899E-20, 0.6234726653058522E-23,
+    -.9991549123491221E-26, 0.1372465538941102E-28, -.1633887546358454E-31, 0.1701966194123390E-34
+};
+
+inline constexpr double l_ser2[16] = {
+    0.2500000000000000E+00, -.2343750000000000E-01, 0.7957175925925926E-03, -.1412850839120370E-04,
+    0.1548484519675926E-06, -.1153828185281636E-08, 0.6230136717695511E-11, -.2550971742728932E-13,
+    0.8195247730999099E-16, -.2121234517551702E-18, 0.4518746345057852E-21, -.8061529302289970E-24,
+    0.1222094716680443E-26, -.1593806157473552E-29, 0.1807204342667468E-32, -.1798089518115172E-35
+};
+
+inline constexpr double l_ser2der[16] = {
+    0.5000000000000000E+00, -.9375000000000000E-01, 0.4774305555555556E-02, -.1130280671296296E-03,
+    0.1548484519675926E-05, -.1384593822337963E-07, 0.8722191404773715E-10, -.4081554788366291E-12,
+    0.1475144591579838E-14, -.4242469035103405E-17, 0.9941241959127275E-20, -.1934767032549593E-22,
+    0.3177446263369152E-25, -.4462657240925946E-28, 0.5421613028002404E-31, -.5753886457968550E-34
+};
+
+template <class VEC_T>
+class Complex {
+  public:
+    VEC_T re, im;
+};
+
+template <class VEC_T>
+inline Complex<VEC_T> operator+(const Complex<VEC_T> &a, const Complex<VEC_T> &b) {
+    return {a.re + b.re, a.im + b.im};
+}
+
+template <class VEC_T>
+inline Complex<VEC_T> operator-(const Complex<VEC_T> &a, const Complex<VEC_T> &b) {
+    return {a.re - b.re, a.im - b.im};
+}
+
+template <class VEC_T>
+inline Complex<VEC_T> operator-(const Complex<VEC_T> &a) {
+    return {-a.re, -a.im};
+}
+
+template <class VEC_T>
+inline Complex<VEC_T> operator*(const Complex<VEC_T> &a, const Complex<VEC_T> &b) {
+    return {mul_sub(a.re, b.re, a.im * b.im), mul_add(a.re, b.im, a.im * b.re)};
+}
+
+template <class VEC_T>
+inline Complex<VEC_T> operator*(const VEC_T &a, const Complex<VEC_T> &b) {
+    return {a * b.re, a * b.im};
+}
+
+// i * a
+template <class VEC_T>
+inline Complex<VEC_T> times_i(const Complex<VEC_T> &a) {
+    return {-a.im, a.re};
+}
+
+template <class VEC_T>
+inline Complex<VEC_T> inverse(const Complex<VEC_T> &z) {
+    const VEC_T scale = 1.0 / mul_add(z.re, z.re, z.im * z.im);
+    return {z.re * scale, -z.im * scale};
+}
+
+// Principal branch, as cdsqrt. The larger component is t = sqrt((|z| + |re|) / 2) and the other one im / (2 t), which
+// avoids the cancellation in |z| - |re|.
+template <class VEC_T>
+inline Complex<VEC_T> csqrt(const Complex<VEC_T> &z) {
+    const VEC_T r = sqrt(mul_add(z.re, z.re, z.im * z.im));
+    const VEC_T t = sqrt(0.5 * (r + abs(z.re)));
+    const VEC_T u = 0.5 * z.im / t;
+    const auto right = z.re >= 0.0;
+    return {select(right, t, abs(u)), select(right, u, sign_combine(t, z.im))};
+}
+
+// exp(i z)
+template <class VEC_T>
+inline Complex<VEC_T> cexp_i(const Complex<VEC_T> &z) {
+    VEC_T c;
+    const VEC_T s = sincos(&c, z.re);
+    const VEC_T e = exp(-z.im);
+    return {e * c, e * s};
+}
+
+template <class VEC_T>
+inline Complex<VEC_T> clog(const Complex<VEC_T> &z) {
+    return {0.5 * log(mul_add(z.re, z.re, z.im * z.im)), atan2(z.im, z.re)};
+}
+
+// Horner's rule in z over m complex coefficients stored as (re, im) pairs, as hank103p
+template <class VEC_T>
+inline Complex<VEC_T> cpoly(const double *p, int m, const Complex<VEC_T> &z) {
+    Complex<VEC_T> f{VEC_T(p[2 * m - 2]), VEC_T(p[2 * m - 1])};
+    for (int i = m - 2; i >= 0; --i)
+        f = f * z + Complex<VEC_T>{VEC_T(p[2 * i]), VEC_T(p[2 * i + 1])};
+    return f;
+}
+
+// Horner's rule in z over m real coefficients
+template <class VEC_T>
+inline Complex<VEC_T> rpoly(const double *p, int m, const Complex<VEC_T> &z) {
+    Complex<VEC_T> f{VEC_T(p[m - 1]), VEC_T(0.0)};
+    for (int i = m - 2; i >= 0; --i) {
+        f = f * z;
+        f.re += p[i];
+    }
+    return f;
+}
+
+template <class VEC_T>
+inline void blend(const decltype(VEC_T() < 0.0) &mask, Complex<VEC_T> &dst, const Complex<VEC_T> &src) {
+    dst.re = select(mask, src.re, dst.re);
+    dst.im = select(mask, src.im, dst.im);
+}
+
+// hank103l, |z| < 1
+template <class VEC_T>
+inline void hank103l(const Complex<VEC_T> &z, Complex<VEC_T> &h0, Complex<VEC_T> &h1) {
+    const double gamma = 0.5772156649015328606;
+    const double two_over_pi = 2.0 / 0.31415926535897932E+01;
+
+    const Complex<VEC_T> z2 = z * z;
+    Complex<VEC_T> fj0{VEC_T(0.0), VEC_T(0.0)}, fj1 = fj0, y0 = fj0, y1 = fj0;
+    Complex<VEC_T> cd{VEC_T(1.0), VEC_T(0.0)};
+    for (int i = 0; i < 16; ++i) {
+        fj0 = fj0 + VEC_T(l_cj0[i]) * cd;
+        fj1 = fj1 + VEC_T(l_cj1[i]) * cd;
+        y1 = y1 + VEC_T(l_ser2der[i]) * cd;
+        cd = cd * z2;
+        y0 = y0 + VEC_T(l_ser2[i]) * cd;
+    }
+    fj1 = -(fj1 * z);
+
+    Complex<VEC_T> cdddlog = clog(VEC_T(0.5) * z);
+    cdddlog.re += gamma;
+    y0 = VEC_T(two_over_pi) * (cdddlog * fj0 + y0);
+    y1 = VEC_T(-two_over_pi) * (fj0 * inverse(z) + y1 * z - cdddlog * fj1);
+
+    h0 = fj0 + times_i(y0);
+    h1 = fj1 + times_i(y1);
+}
+
+// hank103a, |z| > 20
+template <class VEC_T>
+inline void hank103a(const Complex<VEC_T> &z, Complex<VEC_T> &h0, Complex<VEC_T> &h1) {
+    const Complex<VEC_T> cdumb{VEC_T(0.70710678118654757), VEC_T(-0.70710678118654746)};
+    const double two_over_pi = 2.0 / 0.31415926535897932E+01;
+
+    const Complex<VEC_T> zinv = inverse(z);
+    const Complex<VEC_T> zinv22 = zinv * zinv;
+    const Complex<VEC_T> pp = rpoly(a_p, 10, zinv22);
+    const Complex<VEC_T> pp1 = rpoly(a_p1, 10, zinv22);
+    const Complex<VEC_T> qq = rpoly(a_q, 10, zinv22) * zinv;
+    const Complex<VEC_T> qq1 = rpoly(a_q1, 10, zinv22) * zinv;
+
+    const Complex<VEC_T> scale = csqrt(VEC_T(two_over_pi) * zinv) * cdumb * cexp_i(z);
+    h0 = scale * (pp + times_i(qq));
+    h1 = -times_i(scale * (pp1 + times_i(qq1)));
+}
+
+// hank103u with ifexpon = 1, Im z >= 0. Every regime present in the vector is evaluated on all lanes and blended in,
+// so the cost of a vector is that of the most expensive mix of regimes it contains.
+template <class VEC_T>
+inline void hank103u(const Complex<VEC_T> &z, Complex<VEC_T> &h0, Complex<VEC_T> &h1) {
+    const VEC_T d = mul_add(z.re, z.re, z.im * z.im);
+    const auto local = d < 1.0;
+    const auto asymptotic = d > 400.0;
+    const auto near = !local && d <= 13.69;
+    const auto far = d > 13.69 && !asymptotic;
+    const VEC_T nan(std::numeric_limits<double>::quiet_NaN());
+    h0 = h1 = {nan, nan};
+
+    if (horizontal_or(near || far)) {
+        const Complex<VEC_T> cd = inverse(csqrt(z));
+        const Complex<VEC_T> ccex = cd * cexp_i(z);
+        if (horizontal_or(near)) {
+            const Complex<VEC_T> z2 = z * z, z4 = z2 * z2;
+            const Complex<VEC_T> scale = ccex * (z4 * z4 * z);
+            blend(near, h0, cpoly(u_c0p1, 35, cd) * scale);
+            blend(near, h1, cpoly(u_c1p1, 35, cd) * scale);
+        }
+        if (horizontal_or(far)) {
+            blend(far, h0, cpoly(u_c0p2, 31, cd) * ccex);
+            blend(far, h1, cpoly(u_c1p2, 31, cd) * ccex);
+        }
+    }
+    if (horizontal_or(local)) {
+        Complex<VEC_T> l0, l1;
+        hank103l(z, l0, l1);
+        blend(local, h0, l0);
+        blend(local, h1, l1);
+    }
+    if (horizontal_or(asymptotic)) {
+        Complex<VEC_T> a0, a1;
+        hank103a(z, a0, a1);
+        blend(asymptotic, h0, a0);
+        blend(asymptotic, h1, a1);
+    }
+}
+} // namespace hank103_vec
+
+// H0(z), H1(z) over split real / imaginary buffers. Lanes in the lower half plane, where hank103 reflects through
+// hank103r, are recomputed with the scalar Fortran routine.
+template <class VEC_T>
+soa_eval_func_cdx_x2 hank103_soa() {
+    static const auto fn = [](const double *z_re, const double *z_im, double *h0_re, double *h0_im, double *h1_re,
+                              double *h1_im, size_t N) {
+        using hank103_vec::Complex;
+        constexpr size_t VecLen = VEC_T::size();
+        for (size_t i = 0; i < N; i += VecLen) {
+            const size_t n = std::min(VecLen, N - i);
+            Complex<VEC_T> z, h0, h1;
+            if (n == VecLen) {
+                z.re.load(z_re + i);
+                z.im.load(z_im + i);
+            } else {
+                // Pad with the last input, so the unused lanes don't pull in another regime
+                alignas(64) double buf_re[VecLen], buf_im[VecLen];
+                for (size_t j = 0; j < VecLen; ++j) {
+                    buf_re[j] = z_re[std::min(i + j, N - 1)];
+                    buf_im[j] = z_im[std::min(i + j, N - 1)];
+                }
+                z.re.load(buf_re);
+                z.im.load(buf_im);
+            }
+
+            hank103_vec::hank103u(z, h0, h1);
+            h0.re.store_partial(n, h0_re + i);
+            h0.im.store_partial(n, h0_im + i);
+            h1.re.store_partial(n, h1_re + i);
+            h1.im.store_partial(n, h1_im + i);
+
+            if (horizontal_or(z.im < 0.0)) {
+                for (size_t j = i; j < i + n; ++j) {
+                    if (z_im[j] >= 0.0)
+                        continue;
+                    std::complex<double> zj{z_re[j], z_im[j]}, h0j, h1j;
+                    int ifexpon = 1;
+                    hank103_((double _Complex *)&zj, (double _Complex *)&h0j, (double _Complex *)&h1j, &ifexpon);
+                    h0_re[j] = h0j.real();
+                    h0_im[j] = h0j.imag();
+                    h1_re[j] = h1j.real();
+                    h1_im[j] = h1j.imag();
+                }
+            }
+        }
+    };
+    return fn;
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+#include <boost/math/special_functions/erf.hpp>
+
+#include "arena.hpp"
+
+// Where the inputs of an entry fall within its domain. Every distribution maps the same uniform [0, 1) draws, so the
+// inputs only change with the distribution and the domain, not between entries.
+//   uniform       the draws scaled onto the domain
+//   log-uniform   uniform in log|x|, over [1e-8 (upper - lower), upper] for domains that reach down to 0
+//   normal        centered on the domain with sigma 1/6 of its width, clamped to it
+//   cutoffs       within 1e-3 of the domain width around the function's branch cutoffs (or the domain ends)
+//   trace=FILE    values from a file of raw native-endian float64, in file order and repeated as needed, ignoring the
+//                 domain. The file is mapped rather than read, so float64 runs no longer than the trace evaluate it in
+//                 place.
+class InputDist {
+  public:
+    enum Kind { UNIFORM, LOG_UNIFORM, NORMAL, CUTOFFS, TRACE };
+
+    Kind kind = UNIFORM;
+    std::string name = "uniform";
+    MappedRegion trace;
+
+    InputDist() = default;
+
+    InputDist(const std::string &spec) : name(spec) {
+        if (spec == "uniform")
+            kind = UNIFORM;
+        else if (spec == "log-uniform")
+            kind = LOG_UNIFORM;
+        else if (spec == "normal")
+            kind = NORMAL;
+        else if (spec == "cutoffs")
+            kind = CUTOFFS;
+        else if (spec.rfind("trace=", 0) == 0) {
+            kind = TRACE;
+            trace = MappedRegion::map_file(spec.substr(6));
+            if (!trace_size())
+                throw std::runtime_error("Input trace " + spec.substr(6) + " holds no float64 values");
+        } else
+            throw std::runtime_error("Unknown input distribution '" + spec +
+                                     "', expected uniform, log-uniform, normal, cutoffs or trace=FILE");
+    }
+
+    const double *trace_data() const { return static_cast<const double *>(trace.data()); }
+    std::size_t trace_size() const { return trace.size() / sizeof(double); }
+
+    // Inputs on `domain` from uniform draws u in [0, 1), written to x[0, u.size())
+    template <typename Real>
+    void map(const Eigen::VectorX<Real> &u, const std::pair<double, double> &domain, std::vector<double> cutoffs,
+             Real *x) const {
+        const double lower = domain.first, upper = domain.second;
+        if (kind == CUTOFFS) {
+            cutoffs.erase(std::remove_if(cutoffs.begin(), cutoffs.end(),
+                                         [&](double c) { return c < lower || c > upper; }),
+                          cutoffs.end());
+            if (cutoffs.empty())
+                cutoffs = {lower, upper};
+        }
+
+        for (Eigen::Index i = 0; i < u.size(); ++i) {
+            const double t = u[i];
+            double y = lower + t * (upper - lower);
+            if (kind == LOG_UNIFORM) {
+                y = log_uniform(t, lower, upper);
+            } else if (kind == NORMAL) {
+                const double z = M_SQRT2 * boost::math::erf_inv(std::clamp(2 * t - 1, -1 + 1E-16, 1 - 1E-16));
+                y = std::clamp(0.5 * (lower + upper) + z * (upper - lower) / 6, lower, upper);
+            } else if (kind == CUTOFFS) {
+                const std::size_t k = std::min<std::size_t>(t * cutoffs.size(), cutoffs.size() - 1);
+                const double offset = 2 * (t * cutoffs.size() - k) - 1;
+                y = std::clamp(cutoffs[k] + 1E-3 * (upper - lower) * offset, lower, upper);
+            } else if (kind == TRACE) {
+                y = trace_data()[i % trace_size()];
+            }
+            x[i] = Real(y);
+        }
+    }
+
+  private:
+    // Log-uniform magnitudes on each side of zero, with the draws split in proportion to the width of each side
+    static double log_uniform(double t, double lower, double upper) {
+        const double tiny = 1E-8 * (upper - lower);
+        auto log_map = [](double s, double lo, double hi) { return lo * std::pow(hi / lo, s); };
+        if (lower > 0)
+            return log_map(t, lower, upper);
+        if (upper < 0)
+            return -log_map(1 - t, -upper, -lower);
+
+        const double p = -lower / (upper - lower);
+        if (t < p)
+            return -log_map((p - t) / p, tiny, -lower);
+        return log_map((t - p) / (1 - p), tiny, upper);
+    }
+};
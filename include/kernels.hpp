@@ -0,0 +1,367 @@
+#pragma once
+
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "entry_spec.hpp"
+
+typedef std::complex<double> cdouble;
+
+template <class Real>
+using multi_eval_func = std::function<void(const Real *, Real *, size_t)>;
+
+template <class Real, class F>
+std::function<void(const Real *, Real *, size_t)> scalar_func_apply(const F &f) {
+    static const auto fn = [f](const Real *vals, Real *res, size_t N) {
+        for (size_t i = 0; i < N; i++)
+            res[i] = f(vals[i]);
+    };
+    return fn;
+}
+
+// Two real arguments per element, (x, y, res, N): the argument x and a parameter y that varies per element, e.g. the
+// exponent of pow, the divisor of fmod or the integer order of bessel_Jn (truncated). atan2 and hypot take x and y in
+// the order of their C counterparts.
+template <class Real>
+using multi_eval_func2 = std::function<void(const Real *, const Real *, Real *, size_t)>;
+
+template <class Real, class F>
+multi_eval_func2<Real> scalar_func2_apply(const F &f) {
+    static const auto fn = [f](const Real *x, const Real *y, Real *res, size_t N) {
+        for (size_t i = 0; i < N; i++)
+            res[i] = f(x[i], y[i]);
+    };
+    return fn;
+}
+
+// Real argument, two real results in separate (SoA) arrays: (x, y0, y1, N). Computes one of the fused_outputs()
+// tuples, e.g. sincos -> (sin, cos), and is timed per tuple.
+template <class Real>
+using multi_eval_func_x2 = std::function<void(const Real *, Real *, Real *, size_t)>;
+
+template <class Real, class F>
+multi_eval_func_x2<Real> scalar_func_apply_x2(const F &f) {
+    static const auto fn = [f](const Real *vals, Real *res0, Real *res1, size_t N) {
+        for (size_t i = 0; i < N; i++)
+            f(vals[i], res0[i], res1[i]);
+    };
+    return fn;
+}
+
+// The single output functions of each fused key, in output order. Libraries with both outputs get a
+// "<library>-separate" entry of the key as well, which calls the two single output kernels one after the other.
+inline const std::map<std::string, std::pair<std::string, std::string>> &fused_outputs() {
+    static const std::map<std::string, std::pair<std::string, std::string>> outputs = {
+        {"sincos", {"sin", "cos"}},
+        {"bessel_J0J1", {"bessel_J0", "bessel_J1"}},
+        {"bessel_Y0Y1", {"bessel_Y0", "bessel_Y1"}},
+    };
+    return outputs;
+}
+
+// Complex argument, (H0, H1) pair of results, one value per call
+typedef std::function<std::pair<cdouble, cdouble>(cdouble)> fun_cdx1_x2;
+
+// Complex argument, two complex results, in split real / imaginary (SoA) buffers:
+// (z_re, z_im, h0_re, h0_im, h1_re, h1_im, N)
+typedef std::function<void(const double *, const double *, double *, double *, double *, double *, size_t)>
+    soa_eval_func_cdx_x2;
+
+// The timed loop of an entry, n_repeat passes over [0, N), compiled for one kernel, so the kernel is called directly
+// rather than through a std::function per batch. Registered under a "<library>-inline" prefix, next to the
+// type-erased entry of the same kernel.
+template <class Real>
+using multi_eval_loop = std::function<void(const Real *, Real *, size_t, size_t)>;
+
+// The same for (H0, H1) pairs, interleaved in the result. There are no single-output complex loops, which would share
+// the type.
+typedef multi_eval_loop<cdouble> eval_loop_cdx1_x2;
+
+// Keeps the compiler from merging or dropping repeated passes over the same inputs
+inline void pass_barrier() { asm volatile("" ::: "memory"); }
+
+template <class Real, class F>
+multi_eval_loop<Real> scalar_loop_apply(const F &f) {
+    return [f](const Real *vals, Real *res, size_t N, size_t n_repeat) {
+        for (size_t k = 0; k < n_repeat; k++) {
+            for (size_t i = 0; i < N; i++)
+                res[i] = f(vals[i]);
+            pass_barrier();
+        }
+    };
+}
+
+extern "C" {
+void hank103_(double _Complex *, double _Complex *, double _Complex *, int *);
+}
+
+// hank106 interpolates H0, H1 over tables along the ray of arguments r k / |k|, r in [1e-6, 200], built by
+// hank106datagen for the wavenumber k. The benchmark builds them for k = 1 and evaluates at |z| on that ray.
+inline cdouble hank106_ray_point(cdouble z) { return std::abs(z); }
+
+// Each ISA level has its own translation unit of kernels, built with -march=x86-64-v2, -v3 and -v4 respectively, and
+// only called into when the CPU supports it
+enum class ISA { SSE42, AVX2, AVX512 };
+
+inline const char *isa_name(ISA isa) {
+    switch (isa) {
+    case ISA::SSE42:
+        return "sse4.2";
+    case ISA::AVX2:
+        return "avx2";
+    case ISA::AVX512:
+        return "avx512";
+    }
+    return "unknown";
+}
+
+inline ISA parse_isa(const std::string &name) {
+    for (ISA isa : {ISA::SSE42, ISA::AVX2, ISA::AVX512})
+        if (name == isa_name(isa))
+            return isa;
+    throw std::runtime_error("Unknown ISA '" + name + "', expected sse4.2, avx2 or avx512");
+}
+
+// Everything the compiler may emit for the corresponding -march level that the kernels rely on
+inline bool isa_supported(ISA isa) {
+    __builtin_cpu_init();
+    switch (isa) {
+    case ISA::SSE42:
+        return __builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt");
+    case ISA::AVX2:
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") && __builtin_cpu_supports("bmi2");
+    case ISA::AVX512:
+        return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") &&
+               __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl");
+    }
+    return false;
+}
+
+// One library entry, e.g. sleef_dx8, and what the runner needs to know about it. Precision and lane width are taken
+// from the prefix, see EntrySpec.
+template <class FUN_T>
+class KernelTable {
+  public:
+    std::string prefix;
+    std::optional<ISA> isa; // tier the kernels were built for, none for the base level
+    std::unordered_map<std::string, FUN_T> funs;
+
+    // Per function, none of them required
+    std::unordered_map<std::string, std::pair<double, double>> domains; // instead of the default input domain
+    std::unordered_map<std::string, double> setup_times; // one-time cost, e.g. building tables, reported with it
+    std::set<std::string> single_threaded;               // keeps global state, skipped on multithreaded runs
+};
+
+// Every library entry by function type. Tables are kept sorted by precision, then lane width (unspecified last),
+// then library, which is the order they are run in.
+class KernelRegistry {
+  public:
+    std::optional<ISA> current_isa; // tier of the tables added from here on
+
+    template <class FUN_T>
+    std::vector<KernelTable<FUN_T>> &tables() {
+        return std::get<std::vector<KernelTable<FUN_T>>>(tables_);
+    }
+
+    template <class FUN_T>
+    const std::vector<KernelTable<FUN_T>> &tables() const {
+        return std::get<std::vector<KernelTable<FUN_T>>>(tables_);
+    }
+
+    // Table of `prefix`, added if it doesn't exist yet. References are invalidated by adding further tables.
+    template <class FUN_T>
+    KernelTable<FUN_T> &table(const std::string &prefix) {
+        auto &list = tables<FUN_T>();
+        auto it = std::find_if(list.begin(), list.end(), [&](const auto &t) { return t.prefix == prefix; });
+        if (it != list.end())
+            return *it;
+        it = std::find_if(list.begin(), list.end(), [&](const auto &t) { return order(prefix) < order(t.prefix); });
+        it = list.insert(it, KernelTable<FUN_T>());
+        it->prefix = prefix;
+        it->isa = current_isa;
+        return *it;
+    }
+
+    template <class FUN_T>
+    const KernelTable<FUN_T> *find(const std::string &prefix) const {
+        for (const auto &t : tables<FUN_T>())
+            if (t.prefix == prefix)
+                return &t;
+        return nullptr;
+    }
+
+    std::unordered_map<std::string, multi_eval_func<float>> &fx(const std::string &prefix) {
+        return table<multi_eval_func<float>>(prefix).funs;
+    }
+    std::unordered_map<std::string, multi_eval_func<double>> &dx(const std::string &prefix) {
+        return table<multi_eval_func<double>>(prefix).funs;
+    }
+    std::unordered_map<std::string, multi_eval_func<cdouble>> &cdx(const std::string &prefix) {
+        return table<multi_eval_func<cdouble>>(prefix).funs;
+    }
+    std::unordered_map<std::string, multi_eval_func2<float>> &fx_2arg(const std::string &prefix) {
+        return table<multi_eval_func2<float>>(prefix).funs;
+    }
+    std::unordered_map<std::string, multi_eval_func2<double>> &dx_2arg(const std::string &prefix) {
+        return table<multi_eval_func2<double>>(prefix).funs;
+    }
+    std::unordered_map<std::string, multi_eval_func_x2<float>> &fx_x2(const std::string &prefix) {
+        return table<multi_eval_func_x2<float>>(prefix).funs;
+    }
+    std::unordered_map<std::string, multi_eval_func_x2<double>> &dx_x2(const std::string &prefix) {
+        return table<multi_eval_func_x2<double>>(prefix).funs;
+    }
+    std::unordered_map<std::string, fun_cdx1_x2> &cdx_x2(const std::string &prefix) {
+        return table<fun_cdx1_x2>(prefix).funs;
+    }
+    std::unordered_map<std::string, soa_eval_func_cdx_x2> &cdx_soa(const std::string &prefix) {
+        return table<soa_eval_func_cdx_x2>(prefix).funs;
+    }
+    std::unordered_map<std::string, multi_eval_loop<float>> &fx_loop(const std::string &prefix) {
+        return table<multi_eval_loop<float>>(prefix).funs;
+    }
+    std::unordered_map<std::string, multi_eval_loop<double>> &dx_loop(const std::string &prefix) {
+        return table<multi_eval_loop<double>>(prefix).funs;
+    }
+    std::unordered_map<std::string, eval_loop_cdx1_x2> &cdx_x2_loop(const std::string &prefix) {
+        return table<eval_loop_cdx1_x2>(prefix).funs;
+    }
+
+    // f(table) for the tables of every function type
+    template <class F>
+    void for_each_table(const F &f) const {
+        std::apply([&f](const auto &...lists) { (for_each(lists, f), ...); }, tables_);
+    }
+
+    // Names of every registered function
+    std::set<std::string> functions() const {
+        std::set<std::string> names;
+        for_each_table([&names](const auto &t) {
+            for (const auto &kv : t.funs)
+                names.insert(kv.first);
+        });
+        return names;
+    }
+
+  private:
+    std::tuple<std::vector<KernelTable<multi_eval_func<float>>>, std::vector<KernelTable<multi_eval_func<double>>>,
+               std::vector<KernelTable<multi_eval_func<cdouble>>>, std::vector<KernelTable<multi_eval_func2<float>>>,
+               std::vector<KernelTable<multi_eval_func2<double>>>, std::vector<KernelTable<multi_eval_func_x2<float>>>,
+               std::vector<KernelTable<multi_eval_func_x2<double>>>, std::vector<KernelTable<fun_cdx1_x2>>,
+               std::vector<KernelTable<soa_eval_func_cdx_x2>>, std::vector<KernelTable<multi_eval_loop<float>>>,
+               std::vector<KernelTable<multi_eval_loop<double>>>, std::vector<KernelTable<eval_loop_cdx1_x2>>>
+        tables_;
+
+    template <class LIST_T, class F>
+    static void for_each(const LIST_T &list, const F &f) {
+        for (const auto &t : list)
+            f(t);
+    }
+
+    static std::tuple<int, int, std::string> order(const std::string &prefix) {
+        const EntrySpec spec(prefix);
+        const int precision = spec.precision == "f" ? 0 : spec.precision == "d" ? 1 : 2;
+        return {precision, spec.width ? spec.width : 1 << 30, spec.library};
+    }
+};
+
+// A library adds its tables from its own translation unit, with
+//     static const bool registered = register_library(add_tables);
+// at namespace scope. add_tables runs once the registry is built, not during static initialization.
+typedef void (*library_init)(KernelRegistry &registry);
+bool register_library(library_init init);
+
+// The per-ISA kernel units are called into explicitly instead, and only for tiers the CPU supports: their static
+// initializers would run unconditionally, with code built for the tier.
+void add_kernels_sse42(KernelRegistry &registry);
+void add_kernels_avx2(KernelRegistry &registry);
+void add_kernels_avx512(KernelRegistry &registry);
+
+// A minimax approximation of one function on `domain`, fitted in main (see remez.hpp) and compiled into the "remez"
+// (p) and "remez-rational" (p / q) entries of every ISA tier. Coefficients are monomial in t = x * scale() + shift(),
+// which maps the domain onto [-1, 1], constant first, and q[0] is 1.
+class Approximation {
+  public:
+    std::pair<double, double> domain;
+    std::vector<double> p, q; // q empty for polynomials
+    double max_err = 0.0;     // of the double coefficients, on a finer grid than the fit
+    bool relative = true;     // max_err is relative, or absolute for functions with zeros on the domain
+    double fit_time = 0.0;    // of the whole degree search, reported as its setup time
+
+    double scale() const { return 2 / (domain.second - domain.first); }
+    double shift() const { return -(domain.first + domain.second) / (domain.second - domain.first); }
+};
+
+// Highest degree of p with a compiled kernel, and of p and q of rationals, which have equal degrees
+constexpr int max_poly_degree = 32;
+constexpr int max_rational_degree = 16;
+
+typedef std::unordered_map<std::string, Approximation> approximation_map;
+void add_approx_kernels_sse42(KernelRegistry &registry, const std::string &library, const approximation_map &approxs);
+void add_approx_kernels_avx2(KernelRegistry &registry, const std::string &library, const approximation_map &approxs);
+void add_approx_kernels_avx512(KernelRegistry &registry, const std::string &library, const approximation_map &approxs);
+
+// "<library>_dx<width>" entries of `approxs` for each tier of `isas`, with the fit time as setup time
+void add_approx_kernels(KernelRegistry &registry, const std::vector<ISA> &isas, const std::string &library,
+                        const approximation_map &approxs);
+
+// Piecewise Chebyshev fit of one function on dyadic subintervals of `domain`, the scheme of a one-dimensional Baobzi
+// tree, in the flat layout of the "baobzi-simd" entries (see leaf_table.hpp). x falls into cell
+// (x - domain.first) * cell_scale of the finest level, whose leaf record starts at leaves[leaf_of_cell[cell]]: scale
+// and shift, which map the leaf onto t in [-1, 1], then the `order` monomial coefficients in t, constant first.
+class LeafTable {
+  public:
+    std::pair<double, double> domain;
+    int order = 8;
+    double cell_scale = 0.0;
+    std::vector<std::int64_t> leaf_of_cell; // offsets into leaves
+    std::vector<double> leaves;
+    double fit_time = 0.0;
+
+    int stride() const { return order + 2; }
+    std::size_t n_leaves() const { return leaves.size() / stride(); }
+};
+
+// Orders with a compiled baobzi-simd kernel
+constexpr int max_leaf_order = 16;
+
+typedef std::unordered_map<std::string, std::shared_ptr<const LeafTable>> leaf_table_map;
+void add_leaf_kernels_sse42(KernelRegistry &registry, const std::string &library, const leaf_table_map &leaf_tables);
+void add_leaf_kernels_avx2(KernelRegistry &registry, const std::string &library, const leaf_table_map &leaf_tables);
+void add_leaf_kernels_avx512(KernelRegistry &registry, const std::string &library, const leaf_table_map &leaf_tables);
+
+// "<library>_dx<width>" entries of `leaf_tables` for each tier of `isas`, with the fit time as setup time
+void add_leaf_kernels(KernelRegistry &registry, const std::vector<ISA> &isas, const std::string &library,
+                      const leaf_table_map &leaf_tables);
+
+// Dependent FMAs per element of the "fma_peak" roofline entries, whose tables (roofline_<precision><width>) every tier
+// adds next to "stream_copy" and "stream_scale", see --roofline
+constexpr int roofline_fma_chain = 32;
+
+// Every registered library plus the kernels of `isas`, and the "-separate" entries of the fused keys. Throws if the CPU
+// lacks one of the tiers.
+KernelRegistry build_registry(const std::vector<ISA> &isas);
+
+// dlopen handle of AMD's libalm.so, nullptr if it can't be loaded
+void *alm_handle();
+
+// Entry point `name` of libalm.so, nullptr if the library or the symbol is missing. The amdlibm entries exist only for
+// the symbols that resolve: releases differ in what they export, e.g. older ones lack amd_vrd4_pow, and only newer
+// ones have the 512-bit amd_vrd8 and amd_vrs16 variants.
+void *alm_symbol(const std::string &name);
+
+// Packet widths of the Eigen entries, as built for SF_EIGEN_ARCH, e.g. "f32x8,f64x4"
+std::string eigen_packets();
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "kernels.hpp"
+
+// Fit of a LeafTable the way Baobzi builds a tree in one dimension: interpolate f at `order` Chebyshev points of a
+// subinterval and split it in half while the two highest Chebyshev coefficients exceed `tol` in magnitude, down to
+// max_depth halvings of the domain. The finest level sets the number of cells.
+inline LeafTable fit_leaf_table(const std::function<double(double)> &f, const std::pair<double, double> &domain,
+                                int order = 8, double tol = 1E-10, int max_depth = 16) {
+    class Leaf {
+      public:
+        double lower, upper;
+        int depth;
+        std::vector<double> cheb;
+    };
+
+    auto interpolate = [&](double lower, double upper) {
+        const double mid = 0.5 * (lower + upper), half = 0.5 * (upper - lower);
+        std::vector<double> values(order), cheb(order, 0.0);
+        for (int k = 0; k < order; ++k)
+            values[k] = f(mid + half * std::cos(M_PI * (k + 0.5) / order));
+        for (int j = 0; j < order; ++j) {
+            for (int k = 0; k < order; ++k)
+                cheb[j] += values[k] * std::cos(M_PI * j * (k + 0.5) / order);
+            cheb[j] *= (j ? 2.0 : 1.0) / order;
+        }
+        return cheb;
+    };
+
+    std::vector<Leaf> leaves;
+    std::vector<Leaf> todo = {{domain.first, domain.second, 0, interpolate(domain.first, domain.second)}};
+    while (!todo.empty()) {
+        Leaf leaf = todo.back();
+        todo.pop_back();
+        const double tail = std::abs(leaf.cheb[order - 1]) + (order > 1 ? std::abs(leaf.cheb[order - 2]) : 0.0);
+        if (tail <= tol || leaf.depth == max_depth || !std::isfinite(tail)) {
+            leaves.push_back(leaf);
+            continue;
+        }
+        const double mid = 0.5 * (leaf.lower + leaf.upper);
+        todo.push_back({mid, leaf.upper, leaf.depth + 1, interpolate(mid, leaf.upper)});
+        todo.push_back({leaf.lower, mid, leaf.depth + 1, interpolate(leaf.lower, mid)});
+    }
+    std::sort(leaves.begin(), leaves.end(), [](const Leaf &a, const Leaf &b) { return a.lower < b.lower; });
+
+    LeafTable table;
+    table.domain = domain;
+    table.order = order;
+    int depth = 0;
+    for (const auto &leaf : leaves)
+        depth = std::max(depth, leaf.depth);
+    const std::int64_t n_cells = std::int64_t(1) << depth;
+    table.cell_scale = n_cells / (domain.second - domain.first);
+
+    for (const auto &leaf : leaves) {
+        const std::int64_t offset = table.leaves.size();
+        const double half = 0.5 * (leaf.upper - leaf.lower);
+        table.leaves.push_back(1 / half);
+        table.leaves.push_back(-0.5 * (leaf.lower + leaf.upper) / half);
+
+        // Chebyshev to monomial coefficients, through the recurrence T_{k+1} = 2 t T_k - T_{k-1}
+        std::vector<double> mono(order, 0.0), t0(order, 0.0), t1(order, 0.0);
+        t0[0] = 1;
+        if (order > 1)
+            t1[1] = 1;
+        for (int k = 0; k < order; ++k) {
+            for (int i = 0; i < order; ++i)
+                mono[i] += leaf.cheb[k] * t0[i];
+            std::vector<double> t2(order, 0.0);
+            for (int i = 0; i < order; ++i)
+                t2[i] = (i ? 2 * t1[i - 1] : 0.0) - t0[i];
+            t0 = t1;
+            t1 = t2;
+        }
+        table.leaves.insert(table.leaves.end(), mono.begin(), mono.end());
+
+        // Every leaf spans a whole number of cells of the finest level
+        const std::int64_t n_leaf_cells = std::int64_t(1) << (depth - leaf.depth);
+        table.leaf_of_cell.insert(table.leaf_of_cell.end(), n_leaf_cells, offset);
+    }
+    return table;
+}
+
+// f on the inputs grouped by leaf with a counting sort, and the results scattered back into input order, so
+// consecutive evaluations stay in one leaf. The permutation is part of the timed cost. The scratch buffers are per
+// thread and keep their size between calls.
+inline multi_eval_func<double> leaf_bucketed(multi_eval_func<double> f, std::shared_ptr<const LeafTable> table) {
+    return [f, table](const double *x, double *res, size_t N) {
+        thread_local std::vector<std::size_t> start, order;
+        thread_local std::vector<std::uint32_t> leaf;
+        thread_local std::vector<double> xs, ys;
+        start.assign(table->n_leaves() + 1, 0);
+        order.resize(N);
+        leaf.resize(N);
+        xs.resize(N);
+        ys.resize(N);
+
+        const double last_cell = table->leaf_of_cell.size() - 1;
+        for (size_t i = 0; i < N; ++i) {
+            const double cell = std::clamp((x[i] - table->domain.first) * table->cell_scale, 0.0, last_cell);
+            leaf[i] = table->leaf_of_cell[std::size_t(cell)] / table->stride();
+            ++start[leaf[i] + 1];
+        }
+        std::partial_sum(start.begin(), start.end(), start.begin());
+        for (size_t i = 0; i < N; ++i)
+            order[start[leaf[i]]++] = i;
+
+        for (size_t j = 0; j < N; ++j)
+            xs[j] = x[order[j]];
+        f(xs.data(), ys.data(), N);
+        for (size_t j = 0; j < N; ++j)
+            res[order[j]] = ys[j];
+    };
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// Hardware counters of the calling thread around a timed region, via perf_event_open. Every event is opened on its
+// own (not as a group). With inherit set, threads spawned while the counters are enabled are counted too once they are
+// joined; worker threads instead open their own counters without it, so only their timed region counts. When the PMU
+// has fewer counters than events the kernel multiplexes them and readings are scaled by enabled/running time.
+class PerfCounters {
+  public:
+    // Generic names map to the kernel's portable events, "r<hex>" is a raw model-specific event (umask << 8 | event)
+    PerfCounters(const std::vector<std::string> &events, bool inherit = true) {
+        for (auto &name : events) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.disabled = 1;
+            attr.inherit = inherit;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            if (!set_event(name, attr))
+                throw std::runtime_error("Unknown perf event '" + name + "'");
+
+            const int fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+            if (fd < 0) {
+                const bool denied = errno == EACCES || errno == EPERM;
+                std::cerr << "perf_event_open failed for '" << name << "': " << std::strerror(errno)
+                          << (denied ? " (check /proc/sys/kernel/perf_event_paranoid)" : "") << "\n";
+                continue;
+            }
+            names_.push_back(name);
+            fds_.push_back(fd);
+        }
+    }
+
+    ~PerfCounters() {
+        for (auto fd : fds_)
+            close(fd);
+    }
+
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+
+    bool empty() const { return fds_.empty(); }
+    const std::vector<std::string> &names() const { return names_; }
+
+    void start() {
+        for (auto fd : fds_) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    void disable() {
+        for (auto fd : fds_)
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+
+    // Counts since start() as (event, value) pairs
+    std::vector<std::pair<std::string, double>> stop() {
+        disable();
+        return read_counts();
+    }
+
+    // Counts between start() and disable()
+    std::vector<std::pair<std::string, double>> read_counts() const {
+        std::vector<std::pair<std::string, double>> counts;
+        for (std::size_t i = 0; i < fds_.size(); ++i) {
+            std::uint64_t buf[3] = {0, 0, 0}; // value, time_enabled, time_running
+            if (read(fds_[i], buf, sizeof(buf)) != sizeof(buf))
+                continue;
+            const double scale = buf[2] ? double(buf[1]) / buf[2] : 0.0;
+            counts.push_back({names_[i], buf[0] * scale});
+        }
+        return counts;
+    }
+
+    // Adds each count to the one of the same event in `sums`, appending events it doesn't have yet
+    static void accumulate(std::vector<std::pair<std::string, double>> &sums,
+                           const std::vector<std::pair<std::string, double>> &counts) {
+        for (const auto &count : counts) {
+            auto sum = std::find_if(sums.begin(), sums.end(), [&](const auto &s) { return s.first == count.first; });
+            if (sum == sums.end())
+                sums.push_back(count);
+            else
+                sum->second += count.second;
+        }
+    }
+
+    static const std::vector<std::string> &default_events() {
+        static const std::vector<std::string> events = {"cycles", "instructions", "l1d-misses", "llc-misses"};
+        return events;
+    }
+
+  private:
+    std::vector<std::string> names_;
+    std::vector<int> fds_;
+
+    static bool set_event(const std::string &name, perf_event_attr &attr) {
+        auto cache_event = [](std::uint64_t cache, std::uint64_t op, std::uint64_t result) {
+            return cache | (op << 8) | (result << 16);
+        };
+
+        attr.type = PERF_TYPE_HARDWARE;
+        if (name == "cycles")
+            attr.config = PERF_COUNT_HW_CPU_CYCLES;
+        else if (name == "ref-cycles")
+            attr.config = PERF_COUNT_HW_REF_CPU_CYCLES;
+        else if (name == "instructions")
+            attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+        else if (name == "branch-misses")
+            attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+        else if (name == "llc-misses")
+            attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        else if (name == "l1d-misses") {
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config =
+                cache_event(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS);
+        } else if (name.size() > 1 && name[0] == 'r' &&
+                   name.find_first_not_of("0123456789abcdefABCDEF", 1) == std::string::npos) {
+            attr.type = PERF_TYPE_RAW;
+            attr.config = std::stoull(name.substr(1), nullptr, 16);
+        } else
+            return false;
+        return true;
+    }
+};
@@ -0,0 +1,231 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include "kernels.hpp"
+
+// Minimax fits of one function on one domain with the Remez exchange algorithm, see Approximation. The error is
+// relative, or absolute if the function has a zero on the domain (bessel_J0 on [0, 30]). Fits solve for Chebyshev
+// coefficients in long double, which are converted to the monomials the kernels evaluate; the reported error is that
+// of the double coefficients, evaluated in double at points between those of the fit.
+class RemezFitter {
+  public:
+    RemezFitter(const std::function<double(double)> &f, const std::pair<double, double> &domain, int n_grid = 2048)
+        : domain_(domain) {
+        const double scale = 2 / (domain.second - domain.first);
+        const double shift = -(domain.first + domain.second) / (domain.second - domain.first);
+        // Chebyshev points, denser toward the ends where the error of near-minimax fits peaks. The check points sit
+        // between them, at their arguments in double.
+        for (int j = 0; j < n_grid; ++j) {
+            t_.push_back(-std::cos(M_PI * j / (n_grid - 1)));
+            f_.push_back(f(0.5 * (domain.first + domain.second) + 0.5 * (domain.second - domain.first) * t_[j]));
+        }
+        for (int j = 0; j < 4 * n_grid; ++j) {
+            const double x = domain.first + (domain.second - domain.first) * (j + 0.5) / (4 * n_grid);
+            check_t_.push_back(std::fma(x, scale, shift));
+            check_f_.push_back(f(x));
+        }
+
+        relative_ = true;
+        for (const auto &values : {f_, check_f_})
+            for (double y : values)
+                relative_ &= y != 0 && std::signbit(y) == std::signbit(f_[0]) && std::isfinite(y);
+        for (double y : f_)
+            w_.push_back(relative_ ? 1 / std::abs((long double)y) : 1.0L);
+    }
+
+    bool relative() const { return relative_; }
+
+    // Lowest degree whose fit meets `tol`, polynomial or rational with equal degrees, if any up to the maximum
+    std::optional<Approximation> fit_to_tolerance(double tol, bool rational) const {
+        for (int n = 1; n <= (rational ? max_rational_degree : max_poly_degree); ++n)
+            if (auto fit = this->fit(n, rational ? n : 0); fit && fit->max_err <= tol)
+                return fit;
+        return std::nullopt;
+    }
+
+    // Minimax p / q with p of degree n and q of degree m (a polynomial for m = 0), nullopt if even the first solve
+    // fails or has a pole on the domain
+    std::optional<Approximation> fit(int n, int m) const {
+        const int n_ref = n + m + 2;
+        std::vector<int> ref;
+        for (int i = 0; i < n_ref; ++i)
+            ref.push_back(std::lround(double(i) * (t_.size() - 1) / (n_ref - 1)));
+
+        // The iterate with the lowest error, as the exchange can stall or oscillate once the error reaches the
+        // rounding noise of f
+        Vec a, b;
+        long double best = INFINITY;
+        for (int iter = 0; iter < 50; ++iter) {
+            const std::optional<std::pair<Vec, Vec>> sol = solve(ref, n, m);
+            if (!sol)
+                break;
+
+            std::vector<long double> err(t_.size());
+            long double max_err = 0;
+            bool pole = false;
+            for (std::size_t j = 0; j < t_.size(); ++j) {
+                const long double q = 1 + (m ? chebyshev(sol->second, t_[j], 1) : 0.0L);
+                pole |= q <= 0;
+                err[j] = (chebyshev(sol->first, t_[j]) / q - f_[j]) * w_[j];
+                max_err = std::max(max_err, std::abs(err[j]));
+            }
+            if (pole || !std::isfinite(max_err))
+                break;
+            if (max_err < best) {
+                best = max_err;
+                std::tie(a, b) = *sol;
+            }
+
+            const std::vector<int> next = exchange(err, n_ref);
+            if (next.size() != std::size_t(n_ref))
+                break;
+            long double min_ref = INFINITY;
+            for (int j : next)
+                min_ref = std::min(min_ref, std::abs(err[j]));
+            ref = next;
+            // Levelled: the extrema of the error are within 0.1 % of each other
+            if (max_err - min_ref <= 1E-3L * max_err)
+                break;
+        }
+        if (!std::isfinite(best))
+            return std::nullopt;
+
+        Approximation res;
+        res.domain = domain_;
+        res.relative = relative_;
+        const std::vector<long double> p = to_monomial(a);
+        std::vector<long double> q = m ? to_monomial(b, 1) : std::vector<long double>();
+        if (m)
+            q[0] += 1;
+        const long double q0 = m ? q[0] : 1;
+        for (long double c : p)
+            res.p.push_back(double(c / q0));
+        for (long double c : q)
+            res.q.push_back(double(c / q0));
+        if (m)
+            res.q[0] = 1;
+        for (std::size_t j = 0; j < check_t_.size(); ++j) {
+            const double y = m ? horner(res.p, check_t_[j]) / horner(res.q, check_t_[j]) : horner(res.p, check_t_[j]);
+            const double err = std::abs(y - check_f_[j]) / (relative_ ? std::abs(check_f_[j]) : 1.0);
+            if (!std::isfinite(err))
+                return std::nullopt;
+            res.max_err = std::max(res.max_err, err);
+        }
+        return res;
+    }
+
+  private:
+    typedef Eigen::Matrix<long double, Eigen::Dynamic, 1> Vec;
+
+    std::pair<double, double> domain_;
+    std::vector<double> t_, f_;             // fit grid in [-1, 1] and the function on it
+    std::vector<long double> w_;            // error weights on the fit grid
+    std::vector<double> check_t_, check_f_; // check points
+    bool relative_;
+
+    // sum c[k] T_{k + first}(t)
+    static long double chebyshev(const Vec &c, long double t, int first = 0) {
+        long double t0 = 1, t1 = t, res = 0;
+        for (int k = 0; k < first + c.size(); ++k) {
+            if (k >= first)
+                res += c[k - first] * t0;
+            const long double t2 = 2 * t * t1 - t0;
+            t0 = t1;
+            t1 = t2;
+        }
+        return res;
+    }
+
+    // Monomial coefficients of sum c[k] T_{k + first}
+    static std::vector<long double> to_monomial(const Vec &c, int first = 0) {
+        const int n = first + c.size();
+        std::vector<long double> res(n, 0), t0(n, 0), t1(n, 0);
+        t0[0] = 1;
+        if (n > 1)
+            t1[1] = 1;
+        for (int k = 0; k < n; ++k) {
+            if (k >= first)
+                for (int i = 0; i < n; ++i)
+                    res[i] += c[k - first] * t0[i];
+            std::vector<long double> t2(n, 0);
+            for (int i = 0; i < n; ++i)
+                t2[i] = (i ? 2 * t1[i - 1] : 0) - t0[i];
+            t0 = t1;
+            t1 = t2;
+        }
+        return res;
+    }
+
+    static double horner(const std::vector<double> &c, double t) {
+        double res = c.back();
+        for (int k = int(c.size()) - 2; k >= 0; --k)
+            res = std::fma(res, t, c[k]);
+        return res;
+    }
+
+    // Chebyshev coefficients of p (a, degree n) and of q - 1 (b, degree m, from T_1) whose weighted error alternates
+    // with equal magnitude E on the reference points: p - f q = (-1)^i E q / w. For rationals the E q term is
+    // linearized around the previous E until E settles.
+    std::optional<std::pair<Vec, Vec>> solve(const std::vector<int> &ref, int n, int m) const {
+        const int n_ref = ref.size();
+        Eigen::Matrix<long double, Eigen::Dynamic, Eigen::Dynamic> A(n_ref, n_ref);
+        Vec rhs(n_ref), x(n_ref);
+        long double E = 0;
+        for (int inner = 0; inner < (m ? 50 : 1); ++inner) {
+            for (int i = 0; i < n_ref; ++i) {
+                const long double t = t_[ref[i]], f = f_[ref[i]], s = i % 2 ? -1 : 1, w = w_[ref[i]];
+                long double t0 = 1, t1 = t;
+                for (int k = 0; k <= std::max(n, m); ++k) {
+                    if (k <= n)
+                        A(i, k) = t0;
+                    if (k >= 1 && k <= m)
+                        A(i, n + k) = -(f + s * E / w) * t0;
+                    const long double t2 = 2 * t * t1 - t0;
+                    t0 = t1;
+                    t1 = t2;
+                }
+                A(i, n_ref - 1) = -s / w;
+                rhs[i] = f;
+            }
+            x = A.fullPivLu().solve(rhs);
+            if (!x.allFinite())
+                return std::nullopt;
+            const long double E_new = x[n_ref - 1];
+            const bool settled = std::abs(E_new - E) <= 1E-6L * std::abs(E_new);
+            E = E_new;
+            if (settled)
+                break;
+        }
+        return std::pair{Vec(x.head(n + 1)), Vec(x.segment(n + 1, m))};
+    }
+
+    // New reference: the largest error of every run of one sign, then dropping the smaller end until n_ref remain,
+    // which keeps the signs alternating. Fewer than n_ref runs means the fit can't be levelled further.
+    static std::vector<int> exchange(const std::vector<long double> &err, int n_ref) {
+        std::vector<int> res;
+        for (int j = 0; j < int(err.size()); ++j) {
+            if (!res.empty() && std::signbit(err[j]) == std::signbit(err[res.back()])) {
+                if (std::abs(err[j]) > std::abs(err[res.back()]))
+                    res.back() = j;
+            } else {
+                res.push_back(j);
+            }
+        }
+        while (int(res.size()) > n_ref) {
+            if (std::abs(err[res.front()]) < std::abs(err[res.back()]))
+                res.erase(res.begin());
+            else
+                res.pop_back();
+        }
+        return res;
+    }
+};
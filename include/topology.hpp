@@ -0,0 +1,138 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// The CPUs this process may run on, with their NUMA node and core, from sysfs. Machines without NUMA information
+// are one node.
+class Topology {
+  public:
+    class CPU {
+      public:
+        int id;
+        int node = 0;
+        int smt = 0; // index among the hardware threads of its core
+    };
+
+    std::vector<CPU> cpus;
+
+    Topology() {
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        sched_getaffinity(0, sizeof(allowed), &allowed);
+
+        std::map<int, int> node_of_cpu;
+        for (int node = 0;; ++node) {
+            std::ifstream f("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+            if (!f)
+                break;
+            std::string list;
+            std::getline(f, list);
+            for (int cpu : parse_list(list))
+                node_of_cpu[cpu] = node;
+        }
+
+        std::map<std::pair<int, int>, int> threads_per_core;
+        for (int id = 0; id < CPU_SETSIZE; ++id) {
+            if (!CPU_ISSET(id, &allowed))
+                continue;
+            const std::string dir = "/sys/devices/system/cpu/cpu" + std::to_string(id) + "/topology/";
+            const std::pair<int, int> core{read_int(dir + "physical_package_id"), read_int(dir + "core_id", id)};
+            CPU cpu{id};
+            cpu.node = node_of_cpu.count(id) ? node_of_cpu[id] : 0;
+            cpu.smt = threads_per_core[core]++;
+            cpus.push_back(cpu);
+        }
+    }
+
+    int n_nodes() const {
+        int n = 0;
+        for (const auto &cpu : cpus)
+            n = std::max(n, cpu.node + 1);
+        return n;
+    }
+
+    int node_of(int id) const {
+        for (const auto &cpu : cpus)
+            if (cpu.id == id)
+                return cpu.node;
+        return 0;
+    }
+
+    // CPU ids in the order workers are pinned. Both policies take one hardware thread of every core before any
+    // second one. "compact" fills a node before moving to the next, "scatter" deals workers round-robin across nodes,
+    // so two workers already use both sockets.
+    std::vector<int> worker_cpus(const std::string &policy) const {
+        if (policy != "compact" && policy != "scatter")
+            throw std::runtime_error("Unknown pinning policy '" + policy + "', expected compact or scatter");
+
+        std::vector<CPU> order = cpus;
+        std::stable_sort(order.begin(), order.end(), [](const CPU &a, const CPU &b) {
+            return std::tie(a.node, a.smt, a.id) < std::tie(b.node, b.smt, b.id);
+        });
+        std::vector<int> res;
+        if (policy == "compact") {
+            for (const auto &cpu : order)
+                res.push_back(cpu.id);
+            return res;
+        }
+
+        std::vector<std::vector<int>> per_node(n_nodes());
+        for (const auto &cpu : order)
+            per_node[cpu.node].push_back(cpu.id);
+        for (std::size_t i = 0; res.size() < order.size(); ++i)
+            for (const auto &node_cpus : per_node)
+                if (i < node_cpus.size())
+                    res.push_back(node_cpus[i]);
+        return res;
+    }
+
+    // Migrate the pages of [addr, addr + bytes) to `node` and keep them there. Pages that straddle the range are
+    // included. Returns false if the kernel refused, e.g. without NUMA support.
+    static bool move_to_node(void *addr, std::size_t bytes, int node) {
+        const std::uintptr_t page = sysconf(_SC_PAGESIZE);
+        const std::uintptr_t start = std::uintptr_t(addr) / page * page;
+        const std::uintptr_t end = (std::uintptr_t(addr) + bytes + page - 1) / page * page;
+        // MPOL_BIND and MPOL_MF_MOVE from <numaif.h>, which needs libnuma's headers
+        const int mpol_bind = 2, mpol_mf_move = 1 << 1;
+        unsigned long nodemask[16] = {};
+        nodemask[node / (8 * sizeof(long))] = 1UL << (node % (8 * sizeof(long)));
+        return syscall(SYS_mbind, start, end - start, mpol_bind, nodemask, 8 * sizeof(nodemask), mpol_mf_move) == 0;
+    }
+
+  private:
+    // "0-3,8,10-11"
+    static std::vector<int> parse_list(const std::string &list) {
+        std::vector<int> res;
+        std::stringstream ss(list);
+        std::string range;
+        while (std::getline(ss, range, ',')) {
+            if (range.empty())
+                continue;
+            const std::size_t dash = range.find('-');
+            const int first = std::stoi(range.substr(0, dash));
+            const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            for (int cpu = first; cpu <= last; ++cpu)
+                res.push_back(cpu);
+        }
+        return res;
+    }
+
+    static int read_int(const std::string &fname, int fallback = 0) {
+        std::ifstream f(fname);
+        int val;
+        return f >> val ? val : fallback;
+    }
+};
@@ -0,0 +1,399 @@
+#pragma once
+
+// Included by the per-ISA kernel translation units only. Each of them defines VCL_NAMESPACE and SCTL_NAMESPACE first,
+// so the inline functions of vectorclass and SCTL, which are compiled differently at every ISA level, can't be merged
+// across translation units by the linker.
+#if !defined(VCL_NAMESPACE) || !defined(SCTL_NAMESPACE)
+#error "Define VCL_NAMESPACE and SCTL_NAMESPACE before including vec_apply.hpp"
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#include <sctl.hpp>
+#include <vectorclass.h>
+#include <vectormath_exp.h>
+#include <vectormath_hyp.h>
+#include <vectormath_trig.h>
+
+#include "kernels.hpp"
+
+// The vector apply helpers accept any N and unaligned buffers. The remainder past the last full vector goes through one
+// padded vector (sctl) or a masked load/store (vectorclass).
+template <class Real, int VecLen, class F>
+inline void sctl_eval(const F &f, const Real *vals, Real *res, size_t N) {
+    using Vec = SCTL_NAMESPACE::Vec<Real, VecLen>;
+    size_t i = 0;
+    for (; i + VecLen <= N; i += VecLen) {
+        Vec v = Vec::Load(vals + i);
+        f(v).Store(res + i);
+    }
+    if (i < N) {
+        // Pad with the last input so the unused lanes stay inside the function's domain
+        alignas(64) Real buf[VecLen];
+        for (size_t j = 0; j < VecLen; ++j)
+            buf[j] = vals[std::min(i + j, N - 1)];
+        f(Vec::LoadAligned(buf)).StoreAligned(buf);
+        for (size_t j = 0; i + j < N; ++j)
+            res[i + j] = buf[j];
+    }
+}
+
+template <class Real, int VecLen, class F>
+std::function<void(const Real *, Real *, size_t)> sctl_apply(const F &f) {
+    static const auto fn = [f](const Real *vals, Real *res, size_t N) { sctl_eval<Real, VecLen>(f, vals, res, N); };
+    return fn;
+}
+
+// Whole timed loop of an sctl kernel, see multi_eval_loop
+template <class Real, int VecLen, class F>
+multi_eval_loop<Real> sctl_loop_apply(const F &f) {
+    return [f](const Real *vals, Real *res, size_t N, size_t n_repeat) {
+        for (size_t k = 0; k < n_repeat; k++) {
+            sctl_eval<Real, VecLen>(f, vals, res, N);
+            pass_barrier();
+        }
+    };
+}
+
+// Two outputs per input, see multi_eval_func_x2. f(x, y0, y1) sets both vectors of results.
+template <class Real, int VecLen, class F>
+multi_eval_func_x2<Real> sctl_apply_x2(const F &f) {
+    using Vec = SCTL_NAMESPACE::Vec<Real, VecLen>;
+    static const auto fn = [f](const Real *vals, Real *res0, Real *res1, size_t N) {
+        size_t i = 0;
+        Vec y0, y1;
+        for (; i + VecLen <= N; i += VecLen) {
+            f(Vec::Load(vals + i), y0, y1);
+            y0.Store(res0 + i);
+            y1.Store(res1 + i);
+        }
+        if (i < N) {
+            alignas(64) Real buf0[VecLen], buf1[VecLen];
+            for (size_t j = 0; j < VecLen; ++j)
+                buf0[j] = vals[std::min(i + j, N - 1)];
+            f(Vec::LoadAligned(buf0), y0, y1);
+            y0.StoreAligned(buf0);
+            y1.StoreAligned(buf1);
+            for (size_t j = 0; i + j < N; ++j) {
+                res0[i + j] = buf0[j];
+                res1[i + j] = buf1[j];
+            }
+        }
+    };
+    return fn;
+}
+
+template <class VEC_T, class Real, class F>
+inline void vec_eval(const F &f, const Real *vals, Real *res, size_t N) {
+    size_t i = 0;
+    for (; i + VEC_T::size() <= N; i += VEC_T::size()) {
+        VEC_T x;
+        x.load(vals + i);
+        VEC_T y = f(x);
+        y.store(res + i);
+    }
+    if (i < N) {
+        VEC_T x;
+        x.load_partial(N - i, vals + i);
+        VEC_T y = f(x);
+        y.store_partial(N - i, res + i);
+    }
+}
+
+template <class VEC_T, class Real, class F>
+std::function<void(const Real *, Real *, size_t)> vec_func_apply(const F &f) {
+    static const auto fn = [f](const Real *vals, Real *res, size_t N) { vec_eval<VEC_T, Real>(f, vals, res, N); };
+    return fn;
+}
+
+template <class VEC_T, class Real, class F>
+multi_eval_func_x2<Real> vec_func_apply_x2(const F &f) {
+    static const auto fn = [f](const Real *vals, Real *res0, Real *res1, size_t N) {
+        size_t i = 0;
+        VEC_T x, y0, y1;
+        for (; i + VEC_T::size() <= N; i += VEC_T::size()) {
+            x.load(vals + i);
+            f(x, y0, y1);
+            y0.store(res0 + i);
+            y1.store(res1 + i);
+        }
+        if (i < N) {
+            x.load_partial(N - i, vals + i);
+            f(x, y0, y1);
+            y0.store_partial(N - i, res0 + i);
+            y1.store_partial(N - i, res1 + i);
+        }
+    };
+    return fn;
+}
+
+// Two arguments per element, see multi_eval_func2
+template <class VEC_T, class Real, class F>
+inline void vec_eval2(const F &f, const Real *x, const Real *y, Real *res, size_t N) {
+    size_t i = 0;
+    VEC_T vx, vy;
+    for (; i + VEC_T::size() <= N; i += VEC_T::size()) {
+        vx.load(x + i);
+        vy.load(y + i);
+        f(vx, vy).store(res + i);
+    }
+    if (i < N) {
+        vx.load_partial(N - i, x + i);
+        vy.load_partial(N - i, y + i);
+        f(vx, vy).store_partial(N - i, res + i);
+    }
+}
+
+template <class VEC_T, class Real, class F>
+multi_eval_func2<Real> vec_func2_apply(const F &f) {
+    static const auto fn = [f](const Real *x, const Real *y, Real *res, size_t N) {
+        vec_eval2<VEC_T, Real>(f, x, y, res, N);
+    };
+    return fn;
+}
+
+// Double inputs and results through a float kernel, see the -mixed and -refined entries. Each block of inputs is
+// narrowed to float, evaluated by f and widened back; refine(x, xf, y) then returns the result from the widened float
+// result y, the double input x and the input f actually saw, xf = double(float(x)).
+template <class R>
+multi_eval_func<double> mixed_apply(const multi_eval_func<float> &f, const R &refine) {
+    return [f, refine](const double *vals, double *res, size_t N) {
+        constexpr size_t block = 512;
+        alignas(64) float xf[block], yf[block];
+        for (size_t i = 0; i < N; i += block) {
+            const size_t n = std::min(block, N - i);
+            for (size_t j = 0; j < n; ++j)
+                xf[j] = vals[i + j];
+            f(xf, yf, n);
+            for (size_t j = 0; j < n; ++j)
+                res[i + j] = refine(vals[i + j], double(xf[j]), double(yf[j]));
+        }
+    };
+}
+
+constexpr int log2_floor(int n) { return n < 2 ? 0 : 1 + log2_floor(n / 2); }
+
+// c[0] + c[1] t + ... + c[N - 1] t^(N - 1), unrolled for N
+template <int N, class VEC_T>
+inline VEC_T horner(const VEC_T *c, const VEC_T &t) {
+    VEC_T res = c[N - 1];
+    for (int k = N - 2; k >= 0; --k)
+        res = mul_add(res, t, c[k]);
+    return res;
+}
+
+// The same by Estrin's scheme: pairs c[2k] + c[2k + 1] t, combined with t^2, then t^4, and so on, so the dependency
+// chain grows with the log of the degree. t_pow[k] is t^(2^k).
+template <int N, class VEC_T>
+inline VEC_T estrin(const VEC_T *c, const VEC_T *t_pow) {
+    if constexpr (N == 1) {
+        return c[0];
+    } else {
+        constexpr int k = log2_floor(N - 1), half = 1 << k;
+        return mul_add(estrin<N - half>(c + half, t_pow), t_pow[k], estrin<half>(c, t_pow));
+    }
+}
+
+// Kernel of a fitted approximation with p of degree NP and q of degree NQ (none for NQ = 0), see Approximation:
+// Estrin for polynomials, two interleaved Horner chains and a division for rationals
+template <class VEC_T, int NP, int NQ>
+multi_eval_func<double> approx_kernel(const Approximation &a) {
+    std::array<double, NP + 1> p{};
+    std::array<double, NQ + 1> q{};
+    std::copy_n(a.p.begin(), NP + 1, p.begin());
+    std::copy_n(a.q.begin(), NQ ? NQ + 1 : 0, q.begin());
+    return [p, q, scale = a.scale(), shift = a.shift()](const double *vals, double *res, size_t N) {
+        // Broadcast once per call into locals. Loads of the captures can't be hoisted out of the loop, since res
+        // might alias them.
+        VEC_T vp[NP + 1], vq[NQ + 1];
+        for (int k = 0; k <= NP; ++k)
+            vp[k] = VEC_T(p[k]);
+        for (int k = 0; k <= NQ; ++k)
+            vq[k] = VEC_T(q[k]);
+        const VEC_T vscale(scale), vshift(shift);
+
+        vec_eval<VEC_T, double>(
+            [&](const VEC_T &x) -> VEC_T {
+                const VEC_T t = mul_add(x, vscale, vshift);
+                if constexpr (NQ == 0) {
+                    VEC_T t_pow[log2_floor(NP) + 1];
+                    t_pow[0] = t;
+                    for (int k = 1; k <= log2_floor(NP); ++k)
+                        t_pow[k] = t_pow[k - 1] * t_pow[k - 1];
+                    return estrin<NP + 1>(vp, t_pow);
+                } else {
+                    return horner<NP + 1>(vp, t) / horner<NQ + 1>(vq, t);
+                }
+            },
+            vals, res, N);
+    };
+}
+
+// approx_kernel instantiated for the degrees of `a`
+template <class VEC_T, int... NP, int... NR>
+multi_eval_func<double> approx_apply(const Approximation &a, std::integer_sequence<int, NP...>,
+                                     std::integer_sequence<int, NR...>) {
+    const int np = int(a.p.size()) - 1, nq = int(a.q.size()) - 1;
+    multi_eval_func<double> res;
+    if (a.q.empty())
+        ((np == NP + 1 ? (void)(res = approx_kernel<VEC_T, NP + 1, 0>(a)) : (void)0), ...);
+    else if (np == nq)
+        ((np == NR + 1 ? (void)(res = approx_kernel<VEC_T, NR + 1, NR + 1>(a)) : (void)0), ...);
+    return res;
+}
+
+// Entries of `approxs` in the double table of `prefix`, skipping degrees without a compiled kernel
+template <class VEC_T>
+void add_approx_table(KernelRegistry &registry, const std::string &prefix, const approximation_map &approxs) {
+    auto &table = registry.table<multi_eval_func<double>>(prefix);
+    for (const auto &[name, a] : approxs) {
+        auto fun = approx_apply<VEC_T>(a, std::make_integer_sequence<int, max_poly_degree>(),
+                                       std::make_integer_sequence<int, max_rational_degree>());
+        if (!fun)
+            continue;
+        table.funs[name] = fun;
+        table.domains[name] = a.domain;
+        table.setup_times[name] = a.fit_time;
+    }
+}
+
+// Bound of the gather lookups, which index tables of any length. A power of 2, so vectorclass masks the index with it
+// rather than clamping.
+constexpr int gather_bound = 1 << 30;
+
+// Kernel of a LeafTable with ORDER coefficients per leaf: each lane finds its cell, gathers the offset of its leaf and
+// then the leaf's record, and evaluates its polynomial by Horner. Lanes in different leaves cost the same as lanes in
+// one; only the gathers touch more cache lines.
+template <class VEC_T, int ORDER>
+multi_eval_func<double> leaf_kernel(const std::shared_ptr<const LeafTable> &table) {
+    return [table](const double *vals, double *res, size_t N) {
+        const double *leaves = table->leaves.data();
+        const std::int64_t *leaf_of_cell = table->leaf_of_cell.data();
+        const VEC_T lower(table->domain.first), cell_scale(table->cell_scale);
+        const VEC_T last_cell(double(table->leaf_of_cell.size() - 1));
+
+        // Calls with explicit template arguments don't find vectorclass's lookup<n> by argument-dependent lookup
+        using VCL_NAMESPACE::lookup;
+        vec_eval<VEC_T, double>(
+            [&](const VEC_T &x) -> VEC_T {
+                const VEC_T cell = min(max((x - lower) * cell_scale, VEC_T(0.0)), last_cell);
+                const auto leaf = lookup<gather_bound>(truncate_to_int64(cell), leaf_of_cell);
+                const VEC_T scale = lookup<gather_bound>(leaf, leaves), shift = lookup<gather_bound>(leaf + 1, leaves);
+                const VEC_T t = mul_add(x, scale, shift);
+                VEC_T y = lookup<gather_bound>(leaf + (ORDER + 1), leaves);
+                for (int k = ORDER; k >= 2; --k)
+                    y = mul_add(y, t, lookup<gather_bound>(leaf + k, leaves));
+                return y;
+            },
+            vals, res, N);
+    };
+}
+
+// leaf_kernel instantiated for the order of `table`
+template <class VEC_T, int... ORDER>
+multi_eval_func<double> leaf_apply(const std::shared_ptr<const LeafTable> &table,
+                                   std::integer_sequence<int, ORDER...>) {
+    multi_eval_func<double> res;
+    ((table->order == ORDER + 1 ? (void)(res = leaf_kernel<VEC_T, ORDER + 1>(table)) : (void)0), ...);
+    return res;
+}
+
+// Entries of `leaf_tables` in the double table of `prefix`, skipping orders without a compiled kernel
+template <class VEC_T>
+void add_leaf_table(KernelRegistry &registry, const std::string &prefix, const leaf_table_map &leaf_tables) {
+    auto &table = registry.table<multi_eval_func<double>>(prefix);
+    for (const auto &[name, leaf_table] : leaf_tables) {
+        auto fun = leaf_apply<VEC_T>(leaf_table, std::make_integer_sequence<int, max_leaf_order>());
+        if (!fun)
+            continue;
+        table.funs[name] = fun;
+        table.domains[name] = leaf_table->domain;
+        table.setup_times[name] = leaf_table->fit_time;
+    }
+}
+
+// The roofline references of one tier and precision. stream_copy and stream_scale move the bytes of a one input, one
+// output entry with next to no arithmetic. fma_peak runs roofline_fma_chain dependent FMAs on every element, eight
+// vectors at a time so the chains cover the FMA latency, and is bound by the FMA ports rather than memory.
+template <class VEC_T, class Real>
+std::unordered_map<std::string, multi_eval_func<Real>> roofline_funs() {
+    const auto fma_chain = [](VEC_T x) {
+        for (int k = 0; k < roofline_fma_chain; ++k)
+            x = mul_add(x, VEC_T(Real(0.999)), VEC_T(Real(0.001)));
+        return x;
+    };
+    const multi_eval_func<Real> fma_peak = [fma_chain](const Real *x, Real *res, size_t N) {
+        constexpr int n_chains = 8;
+        constexpr size_t block = n_chains * VEC_T::size();
+        size_t i = 0;
+        for (; i + block <= N; i += block) {
+            VEC_T v[n_chains];
+            for (int j = 0; j < n_chains; ++j)
+                v[j].load(x + i + j * VEC_T::size());
+            for (int k = 0; k < roofline_fma_chain; ++k)
+                for (int j = 0; j < n_chains; ++j)
+                    v[j] = mul_add(v[j], VEC_T(Real(0.999)), VEC_T(Real(0.001)));
+            for (int j = 0; j < n_chains; ++j)
+                v[j].store(res + i + j * VEC_T::size());
+        }
+        vec_eval<VEC_T, Real>(fma_chain, x + i, res + i, N - i);
+    };
+
+    return {
+        {"stream_copy", vec_func_apply<VEC_T, Real>([](VEC_T x) { return x; })},
+        {"stream_scale", vec_func_apply<VEC_T, Real>([](VEC_T x) { return x * VEC_T(Real(3)); })},
+        {"fma_peak", fma_peak},
+    };
+}
+
+// AMD libm's vector entry points of VEC_T's width as the amdlibm_<precision><width> entries: amd_vrd<width>_<name>
+// for double, amd_vrs<width>_<name>f for float, for the functions the loaded libalm.so exports (see alm_symbol). The
+// wrappers capture the resolved pointer, so unlike the *_apply helpers there is no static per lambda type. VEC_T goes
+// in and out in one register of its width, as the __m128, __m256 or __m512 arguments of the amd_vr* functions do.
+template <class VEC_T, class Real>
+void add_alm_vector_tables(KernelRegistry &registry) {
+    constexpr bool fp32 = std::is_same_v<Real, float>;
+    const std::string width = std::to_string(VEC_T::size());
+    const auto symbol = [&](const std::string &name) {
+        return alm_symbol(std::string("amd_vr") + (fp32 ? "s" : "d") + width + "_" + name + (fp32 ? "f" : ""));
+    };
+    using C_FUN1 = VEC_T (*)(VEC_T);
+    using C_FUN2 = VEC_T (*)(VEC_T, VEC_T);
+
+    std::unordered_map<std::string, multi_eval_func<Real>> funs;
+    for (const char *name : {"sin", "cos", "tan", "asin", "acos", "atan", "sinh", "cosh", "tanh", "log", "log2",
+                             "log10", "exp", "exp2", "exp10", "expm1", "erf", "sqrt"})
+        if (const auto f = (C_FUN1)symbol(name))
+            funs[name] = [f](const Real *x, Real *res, size_t N) { vec_eval<VEC_T, Real>(f, x, res, N); };
+
+    std::unordered_map<std::string, multi_eval_func2<Real>> funs2;
+    if (const auto f_pow = (C_FUN2)symbol("pow")) {
+        for (const auto &[name, exponent] : {std::pair{"pow3.5", Real(3.5)}, std::pair{"pow13", Real(13)}})
+            funs[name] = [f_pow, exponent = exponent](const Real *x, Real *res, size_t N) {
+                vec_eval<VEC_T, Real>([&](VEC_T v) { return f_pow(v, VEC_T(exponent)); }, x, res, N);
+            };
+        funs2["pow"] = [f_pow](const Real *x, const Real *y, Real *res, size_t N) {
+            vec_eval2<VEC_T, Real>(f_pow, x, y, res, N);
+        };
+    }
+
+    // A release without this width (the shipped one has no amd_vrd8_* or amd_vrs16_*) says so rather than going quiet
+    const std::string prefix = std::string("amdlibm_") + (fp32 ? "fx" : "dx") + width;
+    if (alm_handle() && funs.empty() && funs2.empty())
+        std::cerr << prefix << ": skipped, libalm.so has no amd_vr" << (fp32 ? "s" : "d") << width
+                  << "_* entry points\n";
+    if (!funs.empty())
+        registry.table<multi_eval_func<Real>>(prefix).funs = funs;
+    if (!funs2.empty())
+        registry.table<multi_eval_func2<Real>>(prefix).funs = funs2;
+}
@@ -9,3 +9,25 @@
       REAL*8 x,y
       y = BESSEL_YN(n, x)
       end subroutine
+
+c     Array versions of the above, y(i) = BESSEL_JN(n, x(i)) for i = 1..m,
+c     so the call boundary is crossed once per batch rather than per value
+      subroutine fort_bessel_jn_array(n, x, y, m)
+      INTEGER*4 n
+      INTEGER*8 m, i
+      REAL*8 x(m), y(m)
+!$omp simd
+      do i = 1, m
+         y(i) = BESSEL_JN(n, x(i))
+      end do
+      end subroutine
+
+      subroutine fort_bessel_yn_array(n, x, y, m)
+      INTEGER*4 n
+      INTEGER*8 m, i
+      REAL*8 x(m), y(m)
+!$omp simd
+      do i = 1, m
+         y(i) = BESSEL_YN(n, x(i))
+      end do
+      end subroutine
@@ -0,0 +1,131 @@
+// Kernel registry: the list of registered libraries and the per-ISA tiers
+#include <dlfcn.h>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "kernels.hpp"
+
+// Function local, so libraries can register from static initializers of any translation unit
+static std::vector<library_init> &libraries() {
+    static std::vector<library_init> libs;
+    return libs;
+}
+
+bool register_library(library_init init) {
+    libraries().push_back(init);
+    return true;
+}
+
+// "<library>-separate" entry of every fused key whose outputs a library's table has, e.g. sleef-separate_dx8 sincos
+// calls sleef_dx8 sin and then sleef_dx8 cos over the whole input
+template <class Real>
+static void add_separate_entries(KernelRegistry &registry) {
+    for (const auto &table : registry.tables<multi_eval_func<Real>>()) {
+        const EntrySpec spec(table.prefix);
+        if (!spec.variant().empty())
+            continue;
+        for (const auto &[key, outputs] : fused_outputs()) {
+            const auto &[name0, name1] = outputs;
+            if (!table.funs.count(name0) || !table.funs.count(name1))
+                continue;
+
+            const std::string prefix = spec.library + "-separate" + table.prefix.substr(spec.library.size());
+            auto &separate = registry.table<multi_eval_func_x2<Real>>(prefix);
+            separate.isa = table.isa;
+            separate.funs[key] = [f0 = table.funs.at(name0), f1 = table.funs.at(name1)](const Real *x, Real *y0,
+                                                                                        Real *y1, size_t N) {
+                f0(x, y0, N);
+                f1(x, y1, N);
+            };
+            if (table.domains.count(name0))
+                separate.domains[key] = table.domains.at(name0);
+            for (const auto &name : {name0, name1})
+                if (table.setup_times.count(name))
+                    separate.setup_times[key] += table.setup_times.at(name);
+            if (table.single_threaded.count(name0) || table.single_threaded.count(name1))
+                separate.single_threaded.insert(key);
+        }
+    }
+}
+
+KernelRegistry build_registry(const std::vector<ISA> &isas) {
+    KernelRegistry registry;
+    for (auto init : libraries())
+        init(registry);
+
+    for (ISA isa : isas) {
+        if (!isa_supported(isa))
+            throw std::runtime_error(std::string("This CPU does not support ") + isa_name(isa));
+
+        registry.current_isa = isa;
+        switch (isa) {
+        case ISA::SSE42:
+            add_kernels_sse42(registry);
+            break;
+        case ISA::AVX2:
+            add_kernels_avx2(registry);
+            break;
+        case ISA::AVX512:
+            add_kernels_avx512(registry);
+            break;
+        }
+    }
+    registry.current_isa.reset();
+
+    add_separate_entries<float>(registry);
+    add_separate_entries<double>(registry);
+
+    return registry;
+}
+
+void add_approx_kernels(KernelRegistry &registry, const std::vector<ISA> &isas, const std::string &library,
+                        const approximation_map &approxs) {
+    for (ISA isa : isas) {
+        registry.current_isa = isa;
+        switch (isa) {
+        case ISA::SSE42:
+            add_approx_kernels_sse42(registry, library, approxs);
+            break;
+        case ISA::AVX2:
+            add_approx_kernels_avx2(registry, library, approxs);
+            break;
+        case ISA::AVX512:
+            add_approx_kernels_avx512(registry, library, approxs);
+            break;
+        }
+    }
+    registry.current_isa.reset();
+}
+
+void add_leaf_kernels(KernelRegistry &registry, const std::vector<ISA> &isas, const std::string &library,
+                      const leaf_table_map &leaf_tables) {
+    for (ISA isa : isas) {
+        registry.current_isa = isa;
+        switch (isa) {
+        case ISA::SSE42:
+            add_leaf_kernels_sse42(registry, library, leaf_tables);
+            break;
+        case ISA::AVX2:
+            add_leaf_kernels_avx2(registry, library, leaf_tables);
+            break;
+        case ISA::AVX512:
+            add_leaf_kernels_avx512(registry, library, leaf_tables);
+            break;
+        }
+    }
+    registry.current_isa.reset();
+}
+
+void *alm_handle() {
+    static void *handle = [] {
+        void *res = dlopen("libalm.so", RTLD_NOW);
+        if (!res)
+            std::cerr << "No amdlibm entries: " << dlerror() << "\n";
+        return res;
+    }();
+    return handle;
+}
+
+void *alm_symbol(const std::string &name) { return alm_handle() ? dlsym(alm_handle(), name.c_str()) : nullptr; }
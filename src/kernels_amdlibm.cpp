@@ -0,0 +1,64 @@
+// Scalar entries of AMD's libm, loaded at runtime, for the functions the loaded libalm.so exports (see alm_symbol).
+// The vector entries are with the kernels of each ISA tier.
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#include "kernels.hpp"
+
+// amdlibm_fx1 or amdlibm_dx1, from amd_<name>f or amd_<name>. The wrappers capture the resolved pointer, so unlike
+// scalar_func_apply there is no static per lambda type.
+template <class Real>
+static void add_scalar_tables(KernelRegistry &registry) {
+    constexpr bool fp32 = std::is_same_v<Real, float>;
+    const auto symbol = [](const std::string &name) { return alm_symbol("amd_" + name + (fp32 ? "f" : "")); };
+    using C_FUN1 = Real (*)(Real);
+    using C_FUN2 = Real (*)(Real, Real);
+    using C_SINCOS = void (*)(Real, Real *, Real *);
+
+    std::unordered_map<std::string, multi_eval_func<Real>> funs;
+    for (const char *name : {"sin", "cos", "tan", "sinh", "cosh", "tanh", "asin", "acos", "atan", "asinh", "acosh",
+                             "atanh", "log", "log2", "log10", "exp", "exp2", "exp10", "expm1", "sqrt"})
+        if (const auto f = (C_FUN1)symbol(name))
+            funs[name] = [f](const Real *x, Real *res, size_t N) {
+                for (size_t i = 0; i < N; i++)
+                    res[i] = f(x[i]);
+            };
+
+    std::unordered_map<std::string, multi_eval_func2<Real>> funs2;
+    for (const char *name : {"pow", "atan2", "hypot", "fmod"})
+        if (const auto f = (C_FUN2)symbol(name))
+            funs2[name] = [f](const Real *x, const Real *y, Real *res, size_t N) {
+                for (size_t i = 0; i < N; i++)
+                    res[i] = f(x[i], y[i]);
+            };
+    if (const auto f_pow = (C_FUN2)symbol("pow"))
+        for (const auto &[name, exponent] : {std::pair{"pow3.5", Real(3.5)}, std::pair{"pow13", Real(13)}})
+            funs[name] = [f_pow, exponent = exponent](const Real *x, Real *res, size_t N) {
+                for (size_t i = 0; i < N; i++)
+                    res[i] = f_pow(x[i], exponent);
+            };
+
+    std::unordered_map<std::string, multi_eval_func_x2<Real>> funs_x2;
+    if (const auto f_sincos = (C_SINCOS)symbol("sincos"))
+        funs_x2["sincos"] = [f_sincos](const Real *x, Real *s, Real *c, size_t N) {
+            for (size_t i = 0; i < N; i++)
+                f_sincos(x[i], &s[i], &c[i]);
+        };
+
+    const std::string prefix = fp32 ? "amdlibm_fx1" : "amdlibm_dx1";
+    if (!funs.empty())
+        registry.table<multi_eval_func<Real>>(prefix).funs = funs;
+    if (!funs2.empty())
+        registry.table<multi_eval_func2<Real>>(prefix).funs = funs2;
+    if (!funs_x2.empty())
+        registry.table<multi_eval_func_x2<Real>>(prefix).funs = funs_x2;
+}
+
+static void add_tables(KernelRegistry &registry) {
+    add_scalar_tables<float>(registry);
+    add_scalar_tables<double>(registry);
+}
+
+static const bool registered = register_library(add_tables);
@@ -0,0 +1,338 @@
+// Vector kernels for x86-64-v3 (AVX2 and FMA), and the scalar SLEEF kernels, which are built for FMA
+#include <string>
+#include <unordered_map>
+
+// See vec_apply.hpp
+#define VCL_NAMESPACE vcl_avx2
+#define SCTL_NAMESPACE sctl_avx2
+
+#include <sleef.h>
+
+#include "hank103_vec.hpp"
+#include "kernels.hpp"
+#include "vec_apply.hpp"
+
+namespace sctl = SCTL_NAMESPACE;
+using namespace VCL_NAMESPACE;
+
+typedef sctl::Vec<double, 4> sctl_dx4;
+typedef sctl::Vec<float, 8> sctl_fx8;
+
+void add_kernels_avx2(KernelRegistry &registry) {
+    // AMD libm's 256-bit entry points
+    add_alm_vector_tables<Vec8f, float>(registry);
+    add_alm_vector_tables<Vec4d, double>(registry);
+
+    registry.fx("sleef_fx1") = {
+        {"sin_pi", scalar_func_apply<float>([](float x) -> float { return Sleef_sinpif1_u05purecfma(x); })},
+        {"cos_pi", scalar_func_apply<float>([](float x) -> float { return Sleef_cospif1_u05purecfma(x); })},
+        {"sin", scalar_func_apply<float>([](float x) -> float { return Sleef_sinf1_u10purecfma(x); })},
+        {"cos", scalar_func_apply<float>([](float x) -> float { return Sleef_cosf1_u10purecfma(x); })},
+        {"tan", scalar_func_apply<float>([](float x) -> float { return Sleef_tanf1_u10purecfma(x); })},
+        {"sinh", scalar_func_apply<float>([](float x) -> float { return Sleef_sinhf1_u10purecfma(x); })},
+        {"cosh", scalar_func_apply<float>([](float x) -> float { return Sleef_coshf1_u10purecfma(x); })},
+        {"tanh", scalar_func_apply<float>([](float x) -> float { return Sleef_tanhf1_u10purecfma(x); })},
+        {"asin", scalar_func_apply<float>([](float x) -> float { return Sleef_asinf1_u10purecfma(x); })},
+        {"acos", scalar_func_apply<float>([](float x) -> float { return Sleef_acosf1_u10purecfma(x); })},
+        {"atan", scalar_func_apply<float>([](float x) -> float { return Sleef_atanf1_u10purecfma(x); })},
+        {"asinh", scalar_func_apply<float>([](float x) -> float { return Sleef_asinhf1_u10purecfma(x); })},
+        {"acosh", scalar_func_apply<float>([](float x) -> float { return Sleef_acoshf1_u10purecfma(x); })},
+        {"atanh", scalar_func_apply<float>([](float x) -> float { return Sleef_atanhf1_u10purecfma(x); })},
+        {"log", scalar_func_apply<float>([](float x) -> float { return Sleef_logf1_u10purecfma(x); })},
+        {"log2", scalar_func_apply<float>([](float x) -> float { return Sleef_log2f1_u10purecfma(x); })},
+        {"log10", scalar_func_apply<float>([](float x) -> float { return Sleef_log10f1_u10purecfma(x); })},
+        {"exp", scalar_func_apply<float>([](float x) -> float { return Sleef_expf1_u10purecfma(x); })},
+        {"exp2", scalar_func_apply<float>([](float x) -> float { return Sleef_exp2f1_u10purecfma(x); })},
+        {"exp10", scalar_func_apply<float>([](float x) -> float { return Sleef_exp10f1_u10purecfma(x); })},
+        {"erf", scalar_func_apply<float>([](float x) -> float { return Sleef_erff1_u10purecfma(x); })},
+        {"erfc", scalar_func_apply<float>([](float x) -> float { return Sleef_erfcf1_u15purecfma(x); })},
+        {"lgamma", scalar_func_apply<float>([](float x) -> float { return Sleef_lgammaf1_u10purecfma(x); })},
+        {"tgamma", scalar_func_apply<float>([](float x) -> float { return Sleef_tgammaf1_u10purecfma(x); })},
+        {"sqrt", scalar_func_apply<float>([](float x) -> float { return Sleef_sqrtf1_u05purecfma(x); })},
+        {"pow3.5", scalar_func_apply<float>([](float x) -> float { return Sleef_powf1_u10purecfma(x, 3.5); })},
+        {"pow13", scalar_func_apply<float>([](float x) -> float { return Sleef_powf1_u10purecfma(x, 13); })},
+    };
+
+    registry.dx("sleef_dx1") = {
+        {"sin_pi", scalar_func_apply<double>([](double x) -> double { return Sleef_sinpid1_u05purecfma(x); })},
+        {"cos_pi", scalar_func_apply<double>([](double x) -> double { return Sleef_cospid1_u05purecfma(x); })},
+        {"sin", scalar_func_apply<double>([](double x) -> double { return Sleef_sind1_u10purecfma(x); })},
+        {"cos", scalar_func_apply<double>([](double x) -> double { return Sleef_cosd1_u10purecfma(x); })},
+        {"tan", scalar_func_apply<double>([](double x) -> double { return Sleef_tand1_u10purecfma(x); })},
+        {"sinh", scalar_func_apply<double>([](double x) -> double { return Sleef_sinhd1_u10purecfma(x); })},
+        {"cosh", scalar_func_apply<double>([](double x) -> double { return Sleef_coshd1_u10purecfma(x); })},
+        {"tanh", scalar_func_apply<double>([](double x) -> double { return Sleef_tanhd1_u10purecfma(x); })},
+        {"asin", scalar_func_apply<double>([](double x) -> double { return Sleef_asind1_u10purecfma(x); })},
+        {"acos", scalar_func_apply<double>([](double x) -> double { return Sleef_acosd1_u10purecfma(x); })},
+        {"atan", scalar_func_apply<double>([](double x) -> double { return Sleef_atand1_u10purecfma(x); })},
+        {"asinh", scalar_func_apply<double>([](double x) -> double { return Sleef_asinhd1_u10purecfma(x); })},
+        {"acosh", scalar_func_apply<double>([](double x) -> double { return Sleef_acoshd1_u10purecfma(x); })},
+        {"atanh", scalar_func_apply<double>([](double x) -> double { return Sleef_atanhd1_u10purecfma(x); })},
+        {"log", scalar_func_apply<double>([](double x) -> double { return Sleef_logd1_u10purecfma(x); })},
+        {"log2", scalar_func_apply<double>([](double x) -> double { return Sleef_log2d1_u10purecfma(x); })},
+        {"log10", scalar_func_apply<double>([](double x) -> double { return Sleef_log10d1_u10purecfma(x); })},
+        {"exp", scalar_func_apply<double>([](double x) -> double { return Sleef_expd1_u10purecfma(x); })},
+        {"exp2", scalar_func_apply<double>([](double x) -> double { return Sleef_exp2d1_u10purecfma(x); })},
+        {"exp10", scalar_func_apply<double>([](double x) -> double { return Sleef_exp10d1_u10purecfma(x); })},
+        {"erf", scalar_func_apply<double>([](double x) -> double { return Sleef_erfd1_u10purecfma(x); })},
+        {"erfc", scalar_func_apply<double>([](double x) -> double { return Sleef_erfcd1_u15purecfma(x); })},
+        {"lgamma", scalar_func_apply<double>([](double x) -> double { return Sleef_lgammad1_u10purecfma(x); })},
+        {"tgamma", scalar_func_apply<double>([](double x) -> double { return Sleef_tgammad1_u10purecfma(x); })},
+        {"sqrt", scalar_func_apply<double>([](double x) -> double { return Sleef_sqrtd1_u05purecfma(x); })},
+        {"pow3.5", scalar_func_apply<double>([](double x) -> double { return Sleef_powd1_u10purecfma(x, 3.5); })},
+        {"pow13", scalar_func_apply<double>([](double x) -> double { return Sleef_powd1_u10purecfma(x, 13); })},
+    };
+
+    registry.fx("sleef_fx8") = {
+        {"sin_pi", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_sinpif8_u05avx2(x); })},
+        {"cos_pi", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_cospif8_u05avx2(x); })},
+        {"sin", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_sinf8_u10avx2(x); })},
+        {"cos", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_cosf8_u10avx2(x); })},
+        {"tan", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_tanf8_u10avx2(x); })},
+        {"sinh", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_sinhf8_u10avx2(x); })},
+        {"cosh", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_coshf8_u10avx2(x); })},
+        {"tanh", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_tanhf8_u10avx2(x); })},
+        {"asin", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_asinf8_u10avx2(x); })},
+        {"acos", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_acosf8_u10avx2(x); })},
+        {"atan", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_atanf8_u10avx2(x); })},
+        {"asinh", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_asinhf8_u10avx2(x); })},
+        {"acosh", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_acoshf8_u10avx2(x); })},
+        {"atanh", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_atanhf8_u10avx2(x); })},
+        {"log", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_logf8_u10avx2(x); })},
+        {"log2", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_log2f8_u10avx2(x); })},
+        {"log10", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_log10f8_u10avx2(x); })},
+        {"exp", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_expf8_u10avx2(x); })},
+        {"exp2", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_exp2f8_u10avx2(x); })},
+        {"exp10", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_exp10f8_u10avx2(x); })},
+        {"erf", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_erff8_u10avx2(x); })},
+        {"erfc", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_erfcf8_u15avx2(x); })},
+        {"lgamma", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_lgammaf8_u10avx2(x); })},
+        {"tlgamma", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_tgammaf8_u10avx2(x); })},
+        {"sqrt", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_sqrtf8_u05avx2(x); })},
+        {"pow3.5", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_powf8_u10avx2(x, Vec8f{3.5}); })},
+        {"pow13", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_powf8_u10avx2(x, Vec8f{13}); })},
+    };
+
+    registry.dx("sleef_dx4") = {
+        {"sin_pi", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_sinpid4_u05avx2(x); })},
+        {"cos_pi", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_cospid4_u05avx2(x); })},
+        {"sin", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_sind4_u10avx2(x); })},
+        {"cos", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_cosd4_u10avx2(x); })},
+        {"tan", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_tand4_u10avx2(x); })},
+        {"sinh", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_sinhd4_u10avx2(x); })},
+        {"cosh", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_coshd4_u10avx2(x); })},
+        {"tanh", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_tanhd4_u10avx2(x); })},
+        {"asin", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_asind4_u10avx2(x); })},
+        {"acos", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_acosd4_u10avx2(x); })},
+        {"atan", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_atand4_u10avx2(x); })},
+        {"asinh", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_asinhd4_u10avx2(x); })},
+        {"acosh", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_acoshd4_u10avx2(x); })},
+        {"atanh", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_atanhd4_u10avx2(x); })},
+        {"log", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_logd4_u10avx2(x); })},
+        {"log2", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_log2d4_u10avx2(x); })},
+        {"log10", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_log10d4_u10avx2(x); })},
+        {"exp", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_expd4_u10avx2(x); })},
+        {"exp2", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_exp2d4_u10avx2(x); })},
+        {"exp10", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_exp10d4_u10avx2(x); })},
+        {"erf", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_erfd4_u10avx2(x); })},
+        {"erfc", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_erfcd4_u15avx2(x); })},
+        {"lgamma", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_lgammad4_u10avx2(x); })},
+        {"tlgamma", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_tgammad4_u10avx2(x); })},
+        {"sqrt", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_sqrtd4_u05avx2(x); })},
+        {"pow3.5", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_powd4_u10avx2(x, Vec4d{3.5}); })},
+        {"pow13", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_powd4_u10avx2(x, Vec4d{13}); })},
+    };
+
+    registry.fx("agnerfog_fx8") = {
+        {"sqrt", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return sqrt(x); })},
+        {"sin", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return sin(x); })},
+        {"cos", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return cos(x); })},
+        {"tan", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return tan(x); })},
+        {"sinh", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return sinh(x); })},
+        {"cosh", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return cosh(x); })},
+        {"tanh", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return tanh(x); })},
+        {"asinh", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return asinh(x); })},
+        {"acosh", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return acosh(x); })},
+        {"atanh", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return atanh(x); })},
+        {"asin", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return asin(x); })},
+        {"acos", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return acos(x); })},
+        {"atan", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return atan(x); })},
+        {"exp", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return exp(x); })},
+        {"exp2", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return exp2(x); })},
+        {"exp10", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return exp10(x); })},
+        {"log", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return log(x); })},
+        {"log2", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return log2(x); })},
+        {"log10", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return log10(x); })},
+        {"pow3.5", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return pow(x, 3.5); })},
+        {"pow13", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return pow_const(x, 13); })},
+    };
+
+    registry.dx("agnerfog_dx4") = {
+        {"sqrt", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return sqrt(x); })},
+        {"sin", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return sin(x); })},
+        {"cos", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return cos(x); })},
+        {"tan", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return tan(x); })},
+        {"sinh", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return sinh(x); })},
+        {"cosh", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return cosh(x); })},
+        {"tanh", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return tanh(x); })},
+        {"asinh", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return asinh(x); })},
+        {"acosh", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return acosh(x); })},
+        {"atanh", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return atanh(x); })},
+        {"asin", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return asin(x); })},
+        {"acos", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return acos(x); })},
+        {"atan", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return atan(x); })},
+        {"exp", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return exp(x); })},
+        {"exp2", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return exp2(x); })},
+        {"exp10", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return exp10(x); })},
+        {"log", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return log(x); })},
+        {"log2", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return log2(x); })},
+        {"log10", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return log10(x); })},
+        {"pow3.5", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return pow(x, 3.5); })},
+        {"pow13", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return pow_const(x, 13); })},
+    };
+
+    registry.fx("sctl_fx8") = {
+        {"copy", sctl_apply<float, 8>([](const sctl_fx8 &x) { return x; })},
+        {"exp", sctl_apply<float, 8>([](const sctl_fx8 &x) { return sctl::approx_exp<7>(x); })},
+        {"sin", sctl_apply<float, 8>([](const sctl_fx8 &x) {
+             sctl_fx8 sinx, cosx;
+             sctl::approx_sincos<7>(sinx, cosx, x);
+             return sinx;
+         })},
+        {"cos", sctl_apply<float, 8>([](const sctl_fx8 &x) {
+             sctl_fx8 sinx, cosx;
+             sctl::approx_sincos<7>(sinx, cosx, x);
+             return cosx;
+         })},
+        {"rsqrt", sctl_apply<float, 8>([](const sctl_fx8 &x) { return sctl::approx_rsqrt<7>(x); })},
+    };
+
+    registry.dx("sctl_dx4") = {
+        {"copy", sctl_apply<double, 4>([](const sctl_dx4 &x) { return x; })},
+        {"exp", sctl_apply<double, 4>([](const sctl_dx4 &x) { return sctl::approx_exp<16>(x); })},
+        {"sin", sctl_apply<double, 4>([](const sctl_dx4 &x) {
+             sctl_dx4 sinx, cosx;
+             sctl::approx_sincos<16>(sinx, cosx, x);
+             return sinx;
+         })},
+        {"cos", sctl_apply<double, 4>([](const sctl_dx4 &x) {
+             sctl_dx4 sinx, cosx;
+             sctl::approx_sincos<16>(sinx, cosx, x);
+             return cosx;
+         })},
+        {"rsqrt", sctl_apply<double, 4>([](const sctl_dx4 &x) { return sctl::approx_rsqrt<16>(x); })},
+    };
+
+    // Exponent, coordinates and divisor per element
+    registry.fx_2arg("sleef_fx1") = {
+        {"pow", scalar_func2_apply<float>([](float x, float y) -> float { return Sleef_powf1_u10purecfma(x, y); })},
+        {"atan2", scalar_func2_apply<float>([](float x, float y) -> float { return Sleef_atan2f1_u10purecfma(x, y); })},
+        {"hypot", scalar_func2_apply<float>([](float x, float y) -> float { return Sleef_hypotf1_u05purecfma(x, y); })},
+        {"fmod", scalar_func2_apply<float>([](float x, float y) -> float { return Sleef_fmodf1_purecfma(x, y); })},
+    };
+
+    registry.dx_2arg("sleef_dx1") = {
+        {"pow", scalar_func2_apply<double>([](double x, double y) -> double { return Sleef_powd1_u10purecfma(x, y); })},
+        {"atan2",
+         scalar_func2_apply<double>([](double x, double y) -> double { return Sleef_atan2d1_u10purecfma(x, y); })},
+        {"hypot",
+         scalar_func2_apply<double>([](double x, double y) -> double { return Sleef_hypotd1_u05purecfma(x, y); })},
+        {"fmod", scalar_func2_apply<double>([](double x, double y) -> double { return Sleef_fmodd1_purecfma(x, y); })},
+    };
+
+    registry.fx_2arg("sleef_fx8") = {
+        {"pow", vec_func2_apply<Vec8f, float>([](Vec8f x, Vec8f y) -> Vec8f { return Sleef_powf8_u10avx2(x, y); })},
+        {"atan2", vec_func2_apply<Vec8f, float>([](Vec8f x, Vec8f y) -> Vec8f { return Sleef_atan2f8_u10avx2(x, y); })},
+        {"hypot", vec_func2_apply<Vec8f, float>([](Vec8f x, Vec8f y) -> Vec8f { return Sleef_hypotf8_u05avx2(x, y); })},
+        {"fmod", vec_func2_apply<Vec8f, float>([](Vec8f x, Vec8f y) -> Vec8f { return Sleef_fmodf8_avx2(x, y); })},
+    };
+
+    registry.dx_2arg("sleef_dx4") = {
+        {"pow", vec_func2_apply<Vec4d, double>([](Vec4d x, Vec4d y) -> Vec4d { return Sleef_powd4_u10avx2(x, y); })},
+        {"atan2",
+         vec_func2_apply<Vec4d, double>([](Vec4d x, Vec4d y) -> Vec4d { return Sleef_atan2d4_u10avx2(x, y); })},
+        {"hypot",
+         vec_func2_apply<Vec4d, double>([](Vec4d x, Vec4d y) -> Vec4d { return Sleef_hypotd4_u05avx2(x, y); })},
+        {"fmod", vec_func2_apply<Vec4d, double>([](Vec4d x, Vec4d y) -> Vec4d { return Sleef_fmodd4_avx2(x, y); })},
+    };
+
+    // sincos in one pass: one range reduction (and for SCTL one approx_sincos call) for both outputs
+    registry.fx_x2("sleef_fx1") = {
+        {"sincos", scalar_func_apply_x2<float>([](float x, float &s, float &c) {
+             const auto sc = Sleef_sincosf1_u10purecfma(x);
+             s = sc.x;
+             c = sc.y;
+         })},
+    };
+
+    registry.dx_x2("sleef_dx1") = {
+        {"sincos", scalar_func_apply_x2<double>([](double x, double &s, double &c) {
+             const auto sc = Sleef_sincosd1_u10purecfma(x);
+             s = sc.x;
+             c = sc.y;
+         })},
+    };
+
+    registry.fx_x2("sleef_fx8") = {
+        {"sincos", vec_func_apply_x2<Vec8f, float>([](Vec8f x, Vec8f &s, Vec8f &c) {
+             const auto sc = Sleef_sincosf8_u10avx2(x);
+             s = sc.x;
+             c = sc.y;
+         })},
+    };
+
+    registry.dx_x2("sleef_dx4") = {
+        {"sincos", vec_func_apply_x2<Vec4d, double>([](Vec4d x, Vec4d &s, Vec4d &c) {
+             const auto sc = Sleef_sincosd4_u10avx2(x);
+             s = sc.x;
+             c = sc.y;
+         })},
+    };
+
+    registry.fx_x2("agnerfog_fx8") = {
+        {"sincos", vec_func_apply_x2<Vec8f, float>([](Vec8f x, Vec8f &s, Vec8f &c) { s = sincos(&c, x); })},
+    };
+
+    registry.dx_x2("agnerfog_dx4") = {
+        {"sincos", vec_func_apply_x2<Vec4d, double>([](Vec4d x, Vec4d &s, Vec4d &c) { s = sincos(&c, x); })},
+    };
+
+    registry.fx_x2("sctl_fx8") = {
+        {"sincos", sctl_apply_x2<float, 8>([](const sctl_fx8 &x, sctl_fx8 &s, sctl_fx8 &c) {
+             sctl::approx_sincos<7>(s, c, x);
+         })},
+    };
+
+    registry.dx_x2("sctl_dx4") = {
+        {"sincos", sctl_apply_x2<double, 4>([](const sctl_dx4 &x, sctl_dx4 &s, sctl_dx4 &c) {
+             sctl::approx_sincos<16>(s, c, x);
+         })},
+    };
+
+    // The copy and rsqrt entries again, with the timed loop compiled per kernel
+    registry.fx_loop("sctl-inline_fx8") = {
+        {"copy", sctl_loop_apply<float, 8>([](const sctl_fx8 &x) { return x; })},
+        {"rsqrt", sctl_loop_apply<float, 8>([](const sctl_fx8 &x) { return sctl::approx_rsqrt<7>(x); })},
+    };
+
+    registry.dx_loop("sctl-inline_dx4") = {
+        {"copy", sctl_loop_apply<double, 4>([](const sctl_dx4 &x) { return x; })},
+        {"rsqrt", sctl_loop_apply<double, 4>([](const sctl_dx4 &x) { return sctl::approx_rsqrt<16>(x); })},
+    };
+
+    registry.cdx_soa("hank10x_soa_cdx4") = {
+        {"hank103", hank103_soa<Vec4d>()},
+    };
+
+    // Bandwidth and FMA peak references of this tier, see --roofline
+    registry.fx("roofline_fx8") = roofline_funs<Vec8f, float>();
+    registry.dx("roofline_dx4") = roofline_funs<Vec4d, double>();
+}
+
+void add_approx_kernels_avx2(KernelRegistry &registry, const std::string &library, const approximation_map &approxs) {
+    add_approx_table<Vec4d>(registry, library + "_dx4", approxs);
+}
+
+void add_leaf_kernels_avx2(KernelRegistry &registry, const std::string &library, const leaf_table_map &leaf_tables) {
+    add_leaf_table<Vec4d>(registry, library + "_dx4", leaf_tables);
+}
@@ -0,0 +1,283 @@
+// Vector kernels for x86-64-v4 (AVX-512 F/BW/DQ/VL)
+#include <string>
+#include <unordered_map>
+
+// See vec_apply.hpp
+#define VCL_NAMESPACE vcl_avx512
+#define SCTL_NAMESPACE sctl_avx512
+
+#include <sleef.h>
+
+#include "hank103_vec.hpp"
+#include "kernels.hpp"
+#include "vec_apply.hpp"
+
+namespace sctl = SCTL_NAMESPACE;
+using namespace VCL_NAMESPACE;
+
+typedef sctl::Vec<double, 8> sctl_dx8;
+typedef sctl::Vec<float, 16> sctl_fx16;
+
+// "<library>-mixed_dx8" and "<library>-refined_dx8" from the float kernels of `float_prefix`, next to the library's
+// native double entries. -mixed evaluates every function in float on inputs delivered as double. -refined adds one step
+// in double where there is a cheap one: a Newton step for sqrt and rsqrt, which takes the float result to about 1e-14,
+// and a first order correction for the rounding of the input for exp and log, which leaves the error of the float
+// kernel itself.
+static void add_mixed_tables(KernelRegistry &registry, const std::string &float_prefix, const std::string &library) {
+    const auto floats = registry.fx(float_prefix);
+    std::unordered_map<std::string, multi_eval_func<double>> mixed, refined;
+    for (const auto &[name, f] : floats)
+        mixed[name] = mixed_apply(f, [](double, double, double y) { return y; });
+
+    auto refine = [&](const std::string &name, const auto &step) {
+        if (floats.count(name))
+            refined[name] = mixed_apply(floats.at(name), step);
+    };
+    refine("exp", [](double x, double xf, double y) { return y + y * (x - xf); });
+    refine("log", [](double x, double xf, double y) { return y + (x - xf) / xf; });
+    refine("sqrt", [](double x, double, double y) { return y ? y + 0.5 * (x - y * y) / y : y; });
+    refine("rsqrt", [](double x, double, double y) { return y * (1.5 - 0.5 * x * y * y); });
+
+    registry.dx(library + "-mixed_dx8") = mixed;
+    if (!refined.empty())
+        registry.dx(library + "-refined_dx8") = refined;
+}
+
+void add_kernels_avx512(KernelRegistry &registry) {
+    registry.fx("sleef_fx16") = {
+        {"sin_pi", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_sinpif16_u05avx512f(x); })},
+        {"cos_pi", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_cospif16_u05avx512f(x); })},
+        {"sin", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_sinf16_u10avx512f(x); })},
+        {"cos", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_cosf16_u10avx512f(x); })},
+        {"tan", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_tanf16_u10avx512f(x); })},
+        {"sinh", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_sinhf16_u10avx512f(x); })},
+        {"cosh", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_coshf16_u10avx512f(x); })},
+        {"tanh", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_tanhf16_u10avx512f(x); })},
+        {"asin", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_asinf16_u10avx512f(x); })},
+        {"acos", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_acosf16_u10avx512f(x); })},
+        {"atan", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_atanf16_u10avx512f(x); })},
+        {"asinh", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_asinhf16_u10avx512f(x); })},
+        {"acosh", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_acoshf16_u10avx512f(x); })},
+        {"atanh", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_atanhf16_u10avx512f(x); })},
+        {"log", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_logf16_u10avx512f(x); })},
+        {"log2", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_log2f16_u10avx512f(x); })},
+        {"log10", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_log10f16_u10avx512f(x); })},
+        {"exp", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_expf16_u10avx512f(x); })},
+        {"exp2", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_exp2f16_u10avx512f(x); })},
+        {"exp10", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_exp10f16_u10avx512f(x); })},
+        {"erf", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_erff16_u10avx512f(x); })},
+        {"erfc", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_erfcf16_u15avx512f(x); })},
+        {"lgamma", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_lgammaf16_u10avx512f(x); })},
+        {"tlgamma", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_tgammaf16_u10avx512f(x); })},
+        {"sqrt", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_sqrtf16_u05avx512f(x); })},
+        {"pow3.5",
+         vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_powf16_u10avx512f(x, Vec16f{3.5}); })},
+        {"pow13",
+         vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_powf16_u10avx512f(x, Vec16f{13}); })},
+    };
+
+    registry.dx("sleef_dx8") = {
+        {"sin_pi", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_sinpid8_u05avx512f(x); })},
+        {"cos_pi", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_cospid8_u05avx512f(x); })},
+        {"sin", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_sind8_u10avx512f(x); })},
+        {"cos", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_cosd8_u10avx512f(x); })},
+        {"tan", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_tand8_u10avx512f(x); })},
+        {"sinh", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_sinhd8_u10avx512f(x); })},
+        {"cosh", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_coshd8_u10avx512f(x); })},
+        {"tanh", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_tanhd8_u10avx512f(x); })},
+        {"asin", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_asind8_u10avx512f(x); })},
+        {"acos", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_acosd8_u10avx512f(x); })},
+        {"atan", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_atand8_u10avx512f(x); })},
+        {"asinh", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_asinhd8_u10avx512f(x); })},
+        {"acosh", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_acoshd8_u10avx512f(x); })},
+        {"atanh", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_atanhd8_u10avx512f(x); })},
+        {"log", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_logd8_u10avx512f(x); })},
+        {"log2", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_log2d8_u10avx512f(x); })},
+        {"log10", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_log10d8_u10avx512f(x); })},
+        {"exp", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_expd8_u10avx512f(x); })},
+        {"exp2", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_exp2d8_u10avx512f(x); })},
+        {"exp10", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_exp10d8_u10avx512f(x); })},
+        {"erf", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_erfd8_u10avx512f(x); })},
+        {"erfc", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_erfcd8_u15avx512f(x); })},
+        {"lgamma", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_lgammad8_u10avx512f(x); })},
+        {"tlgamma", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_tgammad8_u10avx512f(x); })},
+        {"sqrt", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_sqrtd8_u05avx512f(x); })},
+        {"pow3.5",
+         vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_powd8_u10avx512f(x, Vec8d{3.5}); })},
+        {"pow13", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_powd8_u10avx512f(x, Vec8d{13}); })},
+    };
+
+    registry.fx("agnerfog_fx16") = {
+        {"sqrt", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return sqrt(x); })},
+        {"sin", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return sin(x); })},
+        {"cos", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return cos(x); })},
+        {"tan", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return tan(x); })},
+        {"sinh", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return sinh(x); })},
+        {"cosh", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return cosh(x); })},
+        {"tanh", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return tanh(x); })},
+        {"asinh", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return asinh(x); })},
+        {"acosh", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return acosh(x); })},
+        {"atanh", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return atanh(x); })},
+        {"asin", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return asin(x); })},
+        {"acos", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return acos(x); })},
+        {"atan", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return atan(x); })},
+        {"exp", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return exp(x); })},
+        {"exp2", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return exp2(x); })},
+        {"exp10", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return exp10(x); })},
+        {"log", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return log(x); })},
+        {"log2", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return log2(x); })},
+        {"log10", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return log10(x); })},
+        {"pow3.5", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return pow(x, 3.5); })},
+        {"pow13", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return pow_const(x, 13); })},
+    };
+
+    registry.dx("agnerfog_dx8") = {
+        {"sqrt", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return sqrt(x); })},
+        {"sin", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return sin(x); })},
+        {"cos", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return cos(x); })},
+        {"tan", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return tan(x); })},
+        {"sinh", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return sinh(x); })},
+        {"cosh", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return cosh(x); })},
+        {"tanh", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return tanh(x); })},
+        {"asinh", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return asinh(x); })},
+        {"acosh", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return acosh(x); })},
+        {"atanh", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return atanh(x); })},
+        {"asin", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return asin(x); })},
+        {"acos", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return acos(x); })},
+        {"atan", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return atan(x); })},
+        {"exp", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return exp(x); })},
+        {"exp2", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return exp2(x); })},
+        {"exp10", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return exp10(x); })},
+        {"log", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return log(x); })},
+        {"log2", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return log2(x); })},
+        {"log10", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return log10(x); })},
+        {"pow3.5", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return pow(x, 3.5); })},
+        {"pow13", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return pow_const(x, 13); })},
+    };
+
+    registry.fx("sctl_fx16") = {
+        {"copy", sctl_apply<float, 16>([](const sctl_fx16 &x) { return x; })},
+        {"exp", sctl_apply<float, 16>([](const sctl_fx16 &x) { return sctl::approx_exp<7>(x); })},
+        {"sin", sctl_apply<float, 16>([](const sctl_fx16 &x) {
+             sctl_fx16 sinx, cosx;
+             sctl::approx_sincos<7>(sinx, cosx, x);
+             return sinx;
+         })},
+        {"cos", sctl_apply<float, 16>([](const sctl_fx16 &x) {
+             sctl_fx16 sinx, cosx;
+             sctl::approx_sincos<7>(sinx, cosx, x);
+             return cosx;
+         })},
+        {"rsqrt", sctl_apply<float, 16>([](const sctl_fx16 &x) { return sctl::approx_rsqrt<7>(x); })},
+    };
+
+    registry.dx("sctl_dx8") = {
+        {"copy", sctl_apply<double, 8>([](const sctl_dx8 &x) { return x; })},
+        {"exp", sctl_apply<double, 8>([](const sctl_dx8 &x) { return sctl::approx_exp<16>(x); })},
+        {"sin", sctl_apply<double, 8>([](const sctl_dx8 &x) {
+             sctl_dx8 sinx, cosx;
+             sctl::approx_sincos<16>(sinx, cosx, x);
+             return sinx;
+         })},
+        {"cos", sctl_apply<double, 8>([](const sctl_dx8 &x) {
+             sctl_dx8 sinx, cosx;
+             sctl::approx_sincos<16>(sinx, cosx, x);
+             return cosx;
+         })},
+        {"rsqrt", sctl_apply<double, 8>([](const sctl_dx8 &x) { return sctl::approx_rsqrt<16>(x); })},
+    };
+
+    // Double precision through the float kernels above
+    add_mixed_tables(registry, "sleef_fx16", "sleef");
+    add_mixed_tables(registry, "agnerfog_fx16", "agnerfog");
+    add_mixed_tables(registry, "sctl_fx16", "sctl");
+
+    // Exponent, coordinates and divisor per element
+    registry.fx_2arg("sleef_fx16") = {
+        {"pow",
+         vec_func2_apply<Vec16f, float>([](Vec16f x, Vec16f y) -> Vec16f { return Sleef_powf16_u10avx512f(x, y); })},
+        {"atan2",
+         vec_func2_apply<Vec16f, float>([](Vec16f x, Vec16f y) -> Vec16f { return Sleef_atan2f16_u10avx512f(x, y); })},
+        {"hypot",
+         vec_func2_apply<Vec16f, float>([](Vec16f x, Vec16f y) -> Vec16f { return Sleef_hypotf16_u05avx512f(x, y); })},
+        {"fmod",
+         vec_func2_apply<Vec16f, float>([](Vec16f x, Vec16f y) -> Vec16f { return Sleef_fmodf16_avx512f(x, y); })},
+    };
+
+    registry.dx_2arg("sleef_dx8") = {
+        {"pow", vec_func2_apply<Vec8d, double>([](Vec8d x, Vec8d y) -> Vec8d { return Sleef_powd8_u10avx512f(x, y); })},
+        {"atan2",
+         vec_func2_apply<Vec8d, double>([](Vec8d x, Vec8d y) -> Vec8d { return Sleef_atan2d8_u10avx512f(x, y); })},
+        {"hypot",
+         vec_func2_apply<Vec8d, double>([](Vec8d x, Vec8d y) -> Vec8d { return Sleef_hypotd8_u05avx512f(x, y); })},
+        {"fmod", vec_func2_apply<Vec8d, double>([](Vec8d x, Vec8d y) -> Vec8d { return Sleef_fmodd8_avx512f(x, y); })},
+    };
+
+    // sincos in one pass: one range reduction (and for SCTL one approx_sincos call) for both outputs
+    registry.fx_x2("sleef_fx16") = {
+        {"sincos", vec_func_apply_x2<Vec16f, float>([](Vec16f x, Vec16f &s, Vec16f &c) {
+             const auto sc = Sleef_sincosf16_u10avx512f(x);
+             s = sc.x;
+             c = sc.y;
+         })},
+    };
+
+    registry.dx_x2("sleef_dx8") = {
+        {"sincos", vec_func_apply_x2<Vec8d, double>([](Vec8d x, Vec8d &s, Vec8d &c) {
+             const auto sc = Sleef_sincosd8_u10avx512f(x);
+             s = sc.x;
+             c = sc.y;
+         })},
+    };
+
+    registry.fx_x2("agnerfog_fx16") = {
+        {"sincos", vec_func_apply_x2<Vec16f, float>([](Vec16f x, Vec16f &s, Vec16f &c) { s = sincos(&c, x); })},
+    };
+
+    registry.dx_x2("agnerfog_dx8") = {
+        {"sincos", vec_func_apply_x2<Vec8d, double>([](Vec8d x, Vec8d &s, Vec8d &c) { s = sincos(&c, x); })},
+    };
+
+    registry.fx_x2("sctl_fx16") = {
+        {"sincos", sctl_apply_x2<float, 16>([](const sctl_fx16 &x, sctl_fx16 &s, sctl_fx16 &c) {
+             sctl::approx_sincos<7>(s, c, x);
+         })},
+    };
+
+    registry.dx_x2("sctl_dx8") = {
+        {"sincos", sctl_apply_x2<double, 8>([](const sctl_dx8 &x, sctl_dx8 &s, sctl_dx8 &c) {
+             sctl::approx_sincos<16>(s, c, x);
+         })},
+    };
+
+    // The copy and rsqrt entries again, with the timed loop compiled per kernel
+    registry.fx_loop("sctl-inline_fx16") = {
+        {"copy", sctl_loop_apply<float, 16>([](const sctl_fx16 &x) { return x; })},
+        {"rsqrt", sctl_loop_apply<float, 16>([](const sctl_fx16 &x) { return sctl::approx_rsqrt<7>(x); })},
+    };
+
+    registry.dx_loop("sctl-inline_dx8") = {
+        {"copy", sctl_loop_apply<double, 8>([](const sctl_dx8 &x) { return x; })},
+        {"rsqrt", sctl_loop_apply<double, 8>([](const sctl_dx8 &x) { return sctl::approx_rsqrt<16>(x); })},
+    };
+
+    registry.cdx_soa("hank10x_soa_cdx8") = {
+        {"hank103", hank103_soa<Vec8d>()},
+    };
+
+    // AMD libm's 512-bit entry points
+    add_alm_vector_tables<Vec16f, float>(registry);
+    add_alm_vector_tables<Vec8d, double>(registry);
+
+    // Bandwidth and FMA peak references of this tier, see --roofline
+    registry.fx("roofline_fx16") = roofline_funs<Vec16f, float>();
+    registry.dx("roofline_dx8") = roofline_funs<Vec8d, double>();
+}
+
+void add_approx_kernels_avx512(KernelRegistry &registry, const std::string &library, const approximation_map &approxs) {
+    add_approx_table<Vec8d>(registry, library + "_dx8", approxs);
+}
+
+void add_leaf_kernels_avx512(KernelRegistry &registry, const std::string &library, const leaf_table_map &leaf_tables) {
+    add_leaf_table<Vec8d>(registry, library + "_dx8", leaf_tables);
+}
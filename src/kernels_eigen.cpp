@@ -0,0 +1,165 @@
+// Coefficient-wise array functions of Eigen, evaluated over the whole batch in one expression. Eigen fixes its packet
+// width at compile time, so this file is built with its own -march, SF_EIGEN_ARCH (see CMakeLists.txt).
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+#include <unsupported/Eigen/SpecialFunctions>
+
+#include "kernels.hpp"
+
+// https://eigen.tuxfamily.org/dox/group__CoeffwiseMathFunctions.html
+namespace OPS {
+enum OPS {
+    COS,
+    SIN,
+    TAN,
+    COSH,
+    SINH,
+    TANH,
+    EXP,
+    LOG,
+    LOG10,
+    POW35,
+    POW13,
+    ASIN,
+    ACOS,
+    ATAN,
+    ASINH,
+    ACOSH,
+    ATANH,
+    ERF,
+    ERFC,
+    LGAMMA,
+    DIGAMMA,
+    NDTRI,
+    SQRT,
+    RSQRT,
+    N_OPS
+};
+}
+
+// OP is a template argument, so every entry is its own loop rather than a switch per call
+template <int OP, typename IN_T, typename OUT_T>
+void eigen_op(const IN_T &x, OUT_T &&res) {
+    switch (OP) {
+    case OPS::COS:
+        res = x.array().cos();
+        break;
+    case OPS::SIN:
+        res = x.array().sin();
+        break;
+    case OPS::TAN:
+        res = x.array().tan();
+        break;
+    case OPS::COSH:
+        res = x.array().cosh();
+        break;
+    case OPS::SINH:
+        res = x.array().sinh();
+        break;
+    case OPS::TANH:
+        res = x.array().tanh();
+        break;
+    case OPS::EXP:
+        res = x.array().exp();
+        break;
+    case OPS::LOG:
+        res = x.array().log();
+        break;
+    case OPS::LOG10:
+        res = x.array().log10();
+        break;
+    case OPS::POW35:
+        res = x.array().pow(3.5);
+        break;
+    case OPS::POW13:
+        res = x.array().pow(13);
+        break;
+    case OPS::ASIN:
+        res = x.array().asin();
+        break;
+    case OPS::ACOS:
+        res = x.array().acos();
+        break;
+    case OPS::ATAN:
+        res = x.array().atan();
+        break;
+    case OPS::ASINH:
+        res = x.array().asinh();
+        break;
+    case OPS::ACOSH:
+        res = x.array().acosh();
+        break;
+    case OPS::ATANH:
+        res = x.array().atanh();
+        break;
+    case OPS::ERF:
+        res = x.array().erf();
+        break;
+    case OPS::ERFC:
+        res = x.array().erfc();
+        break;
+    case OPS::LGAMMA:
+        res = x.array().lgamma();
+        break;
+    case OPS::DIGAMMA:
+        res = x.array().digamma();
+        break;
+    case OPS::NDTRI:
+        res = x.array().ndtri();
+        break;
+    case OPS::SQRT:
+        res = x.array().sqrt();
+        break;
+    case OPS::RSQRT:
+        res = x.array().rsqrt();
+        break;
+    }
+}
+
+// Straight from the input to the result buffer, without temporaries. Buffers aligned to the widest packet (as the
+// arena's are) get aligned packet loads and stores.
+template <typename Real, int OP>
+multi_eval_func<Real> eigen_apply() {
+    return [](const Real *x, Real *res, size_t N) {
+        typedef Eigen::VectorX<Real> Vec;
+        if (std::uintptr_t(x) % EIGEN_MAX_ALIGN_BYTES == 0 && std::uintptr_t(res) % EIGEN_MAX_ALIGN_BYTES == 0)
+            eigen_op<OP>(Eigen::Map<const Vec, Eigen::AlignedMax>(x, N), Eigen::Map<Vec, Eigen::AlignedMax>(res, N));
+        else
+            eigen_op<OP>(Eigen::Map<const Vec>(x, N), Eigen::Map<Vec>(res, N));
+    };
+}
+
+// eigen_apply of every OP, by OP
+template <typename Real, int... OP>
+std::vector<multi_eval_func<Real>> eigen_kernels(std::integer_sequence<int, OP...>) {
+    return {eigen_apply<Real, OP>()...};
+}
+
+std::string eigen_packets() {
+    return "f32x" + std::to_string(Eigen::internal::packet_traits<float>::size) + ",f64x" +
+           std::to_string(Eigen::internal::packet_traits<double>::size);
+}
+
+static void add_tables(KernelRegistry &registry) {
+    static const std::unordered_map<std::string, OPS::OPS> eigen_funs = {
+        {"sin", OPS::SIN},         {"cos", OPS::COS},      {"tan", OPS::TAN},     {"sinh", OPS::SINH},
+        {"cosh", OPS::COSH},       {"tanh", OPS::TANH},    {"exp", OPS::EXP},     {"log", OPS::LOG},
+        {"log10", OPS::LOG10},     {"pow3.5", OPS::POW35}, {"pow13", OPS::POW13}, {"asin", OPS::ASIN},
+        {"acos", OPS::ACOS},       {"atan", OPS::ATAN},    {"asinh", OPS::ASINH}, {"atanh", OPS::ATANH},
+        {"acosh", OPS::ACOSH},     {"erf", OPS::ERF},      {"erfc", OPS::ERFC},   {"lgamma", OPS::LGAMMA},
+        {"digamma", OPS::DIGAMMA}, {"ndtri", OPS::NDTRI},  {"sqrt", OPS::SQRT},   {"rsqrt", OPS::RSQRT},
+    };
+
+    const auto fx = eigen_kernels<float>(std::make_integer_sequence<int, OPS::N_OPS>());
+    const auto dx = eigen_kernels<double>(std::make_integer_sequence<int, OPS::N_OPS>());
+    for (auto &[name, OP] : eigen_funs) {
+        registry.fx("eigen_fxx")[name] = fx[OP];
+        registry.dx("eigen_dxx")[name] = dx[OP];
+    }
+}
+
+static const bool registered = register_library(add_tables);
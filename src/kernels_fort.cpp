@@ -0,0 +1,44 @@
+// Intrinsic Bessel functions of gfortran, see bessel.f
+#include <cstdint>
+
+#include "kernels.hpp"
+
+extern "C" {
+void fort_bessel_jn_(int *, double *, double *);
+void fort_bessel_yn_(int *, double *, double *);
+void fort_bessel_jn_array_(int *, const double *, double *, std::int64_t *);
+void fort_bessel_yn_array_(int *, const double *, double *, std::int64_t *);
+}
+
+static void add_tables(KernelRegistry &registry) {
+    registry.dx("fort_dx1") = {
+        {"bessel_Y0", scalar_func_apply<double>([](double x) -> double {
+             int n = 0;
+             double y;
+             fort_bessel_yn_(&n, &x, &y);
+             return y;
+         })},
+        {"bessel_J0", scalar_func_apply<double>([](double x) -> double {
+             int n = 0;
+             double y;
+             fort_bessel_jn_(&n, &x, &y);
+             return y;
+         })},
+    };
+
+    // The same Fortran intrinsics over whole arrays, one call per batch
+    registry.dx("fort_dxx") = {
+        {"bessel_Y0", [](const double *x, double *y, size_t N) {
+             int n = 0;
+             std::int64_t m = N;
+             fort_bessel_yn_array_(&n, x, y, &m);
+         }},
+        {"bessel_J0", [](const double *x, double *y, size_t N) {
+             int n = 0;
+             std::int64_t m = N;
+             fort_bessel_jn_array_(&n, x, y, &m);
+         }},
+    };
+}
+
+static const bool registered = register_library(add_tables);
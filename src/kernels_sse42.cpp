@@ -0,0 +1,246 @@
+// Vector kernels for x86-64-v2 (SSE4.2), four floats or two doubles per vector
+#include <string>
+#include <unordered_map>
+
+// See vec_apply.hpp
+#define VCL_NAMESPACE vcl_sse42
+#define SCTL_NAMESPACE sctl_sse42
+
+#include <sleef.h>
+
+#include "hank103_vec.hpp"
+#include "kernels.hpp"
+#include "vec_apply.hpp"
+
+namespace sctl = SCTL_NAMESPACE;
+using namespace VCL_NAMESPACE;
+
+typedef sctl::Vec<double, 2> sctl_dx2;
+typedef sctl::Vec<float, 4> sctl_fx4;
+
+void add_kernels_sse42(KernelRegistry &registry) {
+    registry.fx("sleef_fx4") = {
+        {"sin_pi", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return Sleef_sinpif4_u05sse4(x); })},
+        {"cos_pi", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return Sleef_cospif4_u05sse4(x); })},
+        {"sin", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return Sleef_sinf4_u10sse4(x); })},
+        {"cos", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return Sleef_cosf4_u10sse4(x); })},
+        {"tan", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return Sleef_tanf4_u10sse4(x); })},
+        {"sinh", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return Sleef_sinhf4_u10sse4(x); })},
+        {"cosh", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return Sleef_coshf4_u10sse4(x); })},
+        {"tanh", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return Sleef_tanhf4_u10sse4(x); })},
+        {"asin", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return Sleef_asinf4_u10sse4(x); })},
+        {"acos", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return Sleef_acosf4_u10sse4(x); })},
+        {"atan", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return Sleef_atanf4_u10sse4(x); })},
+        {"asinh", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return Sleef_asinhf4_u10sse4(x); })},
+        {"acosh", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return Sleef_acoshf4_u10sse4(x); })},
+        {"atanh", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return Sleef_atanhf4_u10sse4(x); })},
+        {"log", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return Sleef_logf4_u10sse4(x); })},
+        {"log2", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return Sleef_log2f4_u10sse4(x); })},
+        {"log10", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return Sleef_log10f4_u10sse4(x); })},
+        {"exp", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return Sleef_expf4_u10sse4(x); })},
+        {"exp2", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return Sleef_exp2f4_u10sse4(x); })},
+        {"exp10", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return Sleef_exp10f4_u10sse4(x); })},
+        {"erf", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return Sleef_erff4_u10sse4(x); })},
+        {"erfc", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return Sleef_erfcf4_u15sse4(x); })},
+        {"lgamma", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return Sleef_lgammaf4_u10sse4(x); })},
+        {"tlgamma", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return Sleef_tgammaf4_u10sse4(x); })},
+        {"sqrt", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return Sleef_sqrtf4_u05sse4(x); })},
+        {"pow3.5", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return Sleef_powf4_u10sse4(x, Vec4f{3.5}); })},
+        {"pow13", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return Sleef_powf4_u10sse4(x, Vec4f{13}); })},
+    };
+
+    registry.dx("sleef_dx2") = {
+        {"sin_pi", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return Sleef_sinpid2_u05sse4(x); })},
+        {"cos_pi", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return Sleef_cospid2_u05sse4(x); })},
+        {"sin", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return Sleef_sind2_u10sse4(x); })},
+        {"cos", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return Sleef_cosd2_u10sse4(x); })},
+        {"tan", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return Sleef_tand2_u10sse4(x); })},
+        {"sinh", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return Sleef_sinhd2_u10sse4(x); })},
+        {"cosh", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return Sleef_coshd2_u10sse4(x); })},
+        {"tanh", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return Sleef_tanhd2_u10sse4(x); })},
+        {"asin", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return Sleef_asind2_u10sse4(x); })},
+        {"acos", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return Sleef_acosd2_u10sse4(x); })},
+        {"atan", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return Sleef_atand2_u10sse4(x); })},
+        {"asinh", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return Sleef_asinhd2_u10sse4(x); })},
+        {"acosh", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return Sleef_acoshd2_u10sse4(x); })},
+        {"atanh", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return Sleef_atanhd2_u10sse4(x); })},
+        {"log", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return Sleef_logd2_u10sse4(x); })},
+        {"log2", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return Sleef_log2d2_u10sse4(x); })},
+        {"log10", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return Sleef_log10d2_u10sse4(x); })},
+        {"exp", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return Sleef_expd2_u10sse4(x); })},
+        {"exp2", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return Sleef_exp2d2_u10sse4(x); })},
+        {"exp10", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return Sleef_exp10d2_u10sse4(x); })},
+        {"erf", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return Sleef_erfd2_u10sse4(x); })},
+        {"erfc", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return Sleef_erfcd2_u15sse4(x); })},
+        {"lgamma", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return Sleef_lgammad2_u10sse4(x); })},
+        {"tlgamma", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return Sleef_tgammad2_u10sse4(x); })},
+        {"sqrt", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return Sleef_sqrtd2_u05sse4(x); })},
+        {"pow3.5", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return Sleef_powd2_u10sse4(x, Vec2d{3.5}); })},
+        {"pow13", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return Sleef_powd2_u10sse4(x, Vec2d{13}); })},
+    };
+
+    registry.fx("agnerfog_fx4") = {
+        {"sqrt", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return sqrt(x); })},
+        {"sin", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return sin(x); })},
+        {"cos", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return cos(x); })},
+        {"tan", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return tan(x); })},
+        {"sinh", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return sinh(x); })},
+        {"cosh", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return cosh(x); })},
+        {"tanh", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return tanh(x); })},
+        {"asinh", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return asinh(x); })},
+        {"acosh", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return acosh(x); })},
+        {"atanh", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return atanh(x); })},
+        {"asin", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return asin(x); })},
+        {"acos", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return acos(x); })},
+        {"atan", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return atan(x); })},
+        {"exp", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return exp(x); })},
+        {"exp2", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return exp2(x); })},
+        {"exp10", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return exp10(x); })},
+        {"log", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return log(x); })},
+        {"log2", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return log2(x); })},
+        {"log10", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return log10(x); })},
+        {"pow3.5", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return pow(x, 3.5); })},
+        {"pow13", vec_func_apply<Vec4f, float>([](Vec4f x) -> Vec4f { return pow_const(x, 13); })},
+    };
+
+    registry.dx("agnerfog_dx2") = {
+        {"sqrt", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return sqrt(x); })},
+        {"sin", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return sin(x); })},
+        {"cos", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return cos(x); })},
+        {"tan", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return tan(x); })},
+        {"sinh", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return sinh(x); })},
+        {"cosh", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return cosh(x); })},
+        {"tanh", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return tanh(x); })},
+        {"asinh", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return asinh(x); })},
+        {"acosh", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return acosh(x); })},
+        {"atanh", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return atanh(x); })},
+        {"asin", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return asin(x); })},
+        {"acos", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return acos(x); })},
+        {"atan", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return atan(x); })},
+        {"exp", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return exp(x); })},
+        {"exp2", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return exp2(x); })},
+        {"exp10", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return exp10(x); })},
+        {"log", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return log(x); })},
+        {"log2", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return log2(x); })},
+        {"log10", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return log10(x); })},
+        {"pow3.5", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return pow(x, 3.5); })},
+        {"pow13", vec_func_apply<Vec2d, double>([](Vec2d x) -> Vec2d { return pow_const(x, 13); })},
+    };
+
+    registry.fx("sctl_fx4") = {
+        {"copy", sctl_apply<float, 4>([](const sctl_fx4 &x) { return x; })},
+        {"exp", sctl_apply<float, 4>([](const sctl_fx4 &x) { return sctl::approx_exp<7>(x); })},
+        {"sin", sctl_apply<float, 4>([](const sctl_fx4 &x) {
+             sctl_fx4 sinx, cosx;
+             sctl::approx_sincos<7>(sinx, cosx, x);
+             return sinx;
+         })},
+        {"cos", sctl_apply<float, 4>([](const sctl_fx4 &x) {
+             sctl_fx4 sinx, cosx;
+             sctl::approx_sincos<7>(sinx, cosx, x);
+             return cosx;
+         })},
+        {"rsqrt", sctl_apply<float, 4>([](const sctl_fx4 &x) { return sctl::approx_rsqrt<7>(x); })},
+    };
+
+    registry.dx("sctl_dx2") = {
+        {"copy", sctl_apply<double, 2>([](const sctl_dx2 &x) { return x; })},
+        {"exp", sctl_apply<double, 2>([](const sctl_dx2 &x) { return sctl::approx_exp<16>(x); })},
+        {"sin", sctl_apply<double, 2>([](const sctl_dx2 &x) {
+             sctl_dx2 sinx, cosx;
+             sctl::approx_sincos<16>(sinx, cosx, x);
+             return sinx;
+         })},
+        {"cos", sctl_apply<double, 2>([](const sctl_dx2 &x) {
+             sctl_dx2 sinx, cosx;
+             sctl::approx_sincos<16>(sinx, cosx, x);
+             return cosx;
+         })},
+        {"rsqrt", sctl_apply<double, 2>([](const sctl_dx2 &x) { return sctl::approx_rsqrt<16>(x); })},
+    };
+
+    // Exponent, coordinates and divisor per element
+    registry.fx_2arg("sleef_fx4") = {
+        {"pow", vec_func2_apply<Vec4f, float>([](Vec4f x, Vec4f y) -> Vec4f { return Sleef_powf4_u10sse4(x, y); })},
+        {"atan2", vec_func2_apply<Vec4f, float>([](Vec4f x, Vec4f y) -> Vec4f { return Sleef_atan2f4_u10sse4(x, y); })},
+        {"hypot", vec_func2_apply<Vec4f, float>([](Vec4f x, Vec4f y) -> Vec4f { return Sleef_hypotf4_u05sse4(x, y); })},
+        {"fmod", vec_func2_apply<Vec4f, float>([](Vec4f x, Vec4f y) -> Vec4f { return Sleef_fmodf4_sse4(x, y); })},
+    };
+
+    registry.dx_2arg("sleef_dx2") = {
+        {"pow", vec_func2_apply<Vec2d, double>([](Vec2d x, Vec2d y) -> Vec2d { return Sleef_powd2_u10sse4(x, y); })},
+        {"atan2",
+         vec_func2_apply<Vec2d, double>([](Vec2d x, Vec2d y) -> Vec2d { return Sleef_atan2d2_u10sse4(x, y); })},
+        {"hypot",
+         vec_func2_apply<Vec2d, double>([](Vec2d x, Vec2d y) -> Vec2d { return Sleef_hypotd2_u05sse4(x, y); })},
+        {"fmod", vec_func2_apply<Vec2d, double>([](Vec2d x, Vec2d y) -> Vec2d { return Sleef_fmodd2_sse4(x, y); })},
+    };
+
+    // sincos in one pass: one range reduction (and for SCTL one approx_sincos call) for both outputs
+    registry.fx_x2("sleef_fx4") = {
+        {"sincos", vec_func_apply_x2<Vec4f, float>([](Vec4f x, Vec4f &s, Vec4f &c) {
+             const auto sc = Sleef_sincosf4_u10sse4(x);
+             s = sc.x;
+             c = sc.y;
+         })},
+    };
+
+    registry.dx_x2("sleef_dx2") = {
+        {"sincos", vec_func_apply_x2<Vec2d, double>([](Vec2d x, Vec2d &s, Vec2d &c) {
+             const auto sc = Sleef_sincosd2_u10sse4(x);
+             s = sc.x;
+             c = sc.y;
+         })},
+    };
+
+    registry.fx_x2("agnerfog_fx4") = {
+        {"sincos", vec_func_apply_x2<Vec4f, float>([](Vec4f x, Vec4f &s, Vec4f &c) { s = sincos(&c, x); })},
+    };
+
+    registry.dx_x2("agnerfog_dx2") = {
+        {"sincos", vec_func_apply_x2<Vec2d, double>([](Vec2d x, Vec2d &s, Vec2d &c) { s = sincos(&c, x); })},
+    };
+
+    registry.fx_x2("sctl_fx4") = {
+        {"sincos", sctl_apply_x2<float, 4>([](const sctl_fx4 &x, sctl_fx4 &s, sctl_fx4 &c) {
+             sctl::approx_sincos<7>(s, c, x);
+         })},
+    };
+
+    registry.dx_x2("sctl_dx2") = {
+        {"sincos", sctl_apply_x2<double, 2>([](const sctl_dx2 &x, sctl_dx2 &s, sctl_dx2 &c) {
+             sctl::approx_sincos<16>(s, c, x);
+         })},
+    };
+
+    // The copy and rsqrt entries again, with the timed loop compiled per kernel
+    registry.fx_loop("sctl-inline_fx4") = {
+        {"copy", sctl_loop_apply<float, 4>([](const sctl_fx4 &x) { return x; })},
+        {"rsqrt", sctl_loop_apply<float, 4>([](const sctl_fx4 &x) { return sctl::approx_rsqrt<7>(x); })},
+    };
+
+    registry.dx_loop("sctl-inline_dx2") = {
+        {"copy", sctl_loop_apply<double, 2>([](const sctl_dx2 &x) { return x; })},
+        {"rsqrt", sctl_loop_apply<double, 2>([](const sctl_dx2 &x) { return sctl::approx_rsqrt<16>(x); })},
+    };
+
+    registry.cdx_soa("hank10x_soa_cdx2") = {
+        {"hank103", hank103_soa<Vec2d>()},
+    };
+
+    // AMD libm's 128-bit entry points
+    add_alm_vector_tables<Vec4f, float>(registry);
+    add_alm_vector_tables<Vec2d, double>(registry);
+
+    // Bandwidth and FMA peak references of this tier, see --roofline
+    registry.fx("roofline_fx4") = roofline_funs<Vec4f, float>();
+    registry.dx("roofline_dx2") = roofline_funs<Vec2d, double>();
+}
+
+void add_approx_kernels_sse42(KernelRegistry &registry, const std::string &library, const approximation_map &approxs) {
+    add_approx_table<Vec2d>(registry, library + "_dx2", approxs);
+}
+
+void add_leaf_kernels_sse42(KernelRegistry &registry, const std::string &library, const leaf_table_map &leaf_tables) {
+    add_leaf_table<Vec2d>(registry, library + "_dx2", leaf_tables);
+}
@@ -0,0 +1,114 @@
+// Scalar entries of the C++ standard library (glibc libm)
+#include <cmath>
+
+#include "kernels.hpp"
+
+static void add_tables(KernelRegistry &registry) {
+    registry.fx("std_fx1") = {
+        {"copy", scalar_func_apply<float>([](float x) -> float { return x; })},
+        {"tgamma", scalar_func_apply<float>([](float x) -> float { return std::tgamma(x); })},
+        {"lgamma", scalar_func_apply<float>([](float x) -> float { return std::lgamma(x); })},
+        {"sin", scalar_func_apply<float>([](float x) -> float { return std::sin(x); })},
+        {"cos", scalar_func_apply<float>([](float x) -> float { return std::cos(x); })},
+        {"tan", scalar_func_apply<float>([](float x) -> float { return std::tan(x); })},
+        {"asin", scalar_func_apply<float>([](float x) -> float { return std::asin(x); })},
+        {"acos", scalar_func_apply<float>([](float x) -> float { return std::acos(x); })},
+        {"atan", scalar_func_apply<float>([](float x) -> float { return std::atan(x); })},
+        {"sinh", scalar_func_apply<float>([](float x) -> float { return std::sinh(x); })},
+        {"cosh", scalar_func_apply<float>([](float x) -> float { return std::cosh(x); })},
+        {"tanh", scalar_func_apply<float>([](float x) -> float { return std::tanh(x); })},
+        {"asinh", scalar_func_apply<float>([](float x) -> float { return std::asinh(x); })},
+        {"acosh", scalar_func_apply<float>([](float x) -> float { return std::acosh(x); })},
+        {"atanh", scalar_func_apply<float>([](float x) -> float { return std::atanh(x); })},
+        {"sin_pi", scalar_func_apply<float>([](float x) -> float { return std::sin(M_PI * x); })},
+        {"cos_pi", scalar_func_apply<float>([](float x) -> float { return std::cos(M_PI * x); })},
+        {"erf", scalar_func_apply<float>([](float x) -> float { return std::erf(x); })},
+        {"erfc", scalar_func_apply<float>([](float x) -> float { return std::erfc(x); })},
+        {"log", scalar_func_apply<float>([](float x) -> float { return std::log(x); })},
+        {"log2", scalar_func_apply<float>([](float x) -> float { return std::log2(x); })},
+        {"log10", scalar_func_apply<float>([](float x) -> float { return std::log10(x); })},
+        {"exp", scalar_func_apply<float>([](float x) -> float { return std::exp(x); })},
+        {"exp2", scalar_func_apply<float>([](float x) -> float { return std::exp2(x); })},
+        {"exp10", scalar_func_apply<float>([](float x) -> float { return exp10(x); })},
+        {"sqrt", scalar_func_apply<float>([](float x) -> float { return std::sqrt(x); })},
+        {"rsqrt", scalar_func_apply<float>([](float x) -> float { return 1.0 / std::sqrt(x); })},
+        {"pow3.5", scalar_func_apply<float>([](float x) -> float { return std::pow(x, 3.5); })},
+        {"pow13", scalar_func_apply<float>([](float x) -> float { return std::pow(x, 13); })},
+    };
+
+    registry.dx("std_dx1") = {
+        {"copy", scalar_func_apply<double>([](double x) -> double { return x; })},
+        {"tgamma", scalar_func_apply<double>([](double x) -> double { return std::tgamma(x); })},
+        {"lgamma", scalar_func_apply<double>([](double x) -> double { return std::lgamma(x); })},
+        {"sin", scalar_func_apply<double>([](double x) -> double { return std::sin(x); })},
+        {"cos", scalar_func_apply<double>([](double x) -> double { return std::cos(x); })},
+        {"tan", scalar_func_apply<double>([](double x) -> double { return std::tan(x); })},
+        {"asin", scalar_func_apply<double>([](double x) -> double { return std::asin(x); })},
+        {"acos", scalar_func_apply<double>([](double x) -> double { return std::acos(x); })},
+        {"atan", scalar_func_apply<double>([](double x) -> double { return std::atan(x); })},
+        {"sinh", scalar_func_apply<double>([](double x) -> double { return std::sinh(x); })},
+        {"cosh", scalar_func_apply<double>([](double x) -> double { return std::cosh(x); })},
+        {"tanh", scalar_func_apply<double>([](double x) -> double { return std::tanh(x); })},
+        {"asinh", scalar_func_apply<double>([](double x) -> double { return std::asinh(x); })},
+        {"acosh", scalar_func_apply<double>([](double x) -> double { return std::acosh(x); })},
+        {"atanh", scalar_func_apply<double>([](double x) -> double { return std::atanh(x); })},
+        {"sin_pi", scalar_func_apply<double>([](double x) -> double { return std::sin(M_PI * x); })},
+        {"cos_pi", scalar_func_apply<double>([](double x) -> double { return std::cos(M_PI * x); })},
+        {"erf", scalar_func_apply<double>([](double x) -> double { return std::erf(x); })},
+        {"erfc", scalar_func_apply<double>([](double x) -> double { return std::erfc(x); })},
+        {"log", scalar_func_apply<double>([](double x) -> double { return std::log(x); })},
+        {"log2", scalar_func_apply<double>([](double x) -> double { return std::log2(x); })},
+        {"log10", scalar_func_apply<double>([](double x) -> double { return std::log10(x); })},
+        {"exp", scalar_func_apply<double>([](double x) -> double { return std::exp(x); })},
+        {"exp2", scalar_func_apply<double>([](double x) -> double { return std::exp2(x); })},
+        {"exp10", scalar_func_apply<double>([](double x) -> double { return exp10(x); })},
+        {"sqrt", scalar_func_apply<double>([](double x) -> double { return std::sqrt(x); })},
+        {"rsqrt", scalar_func_apply<double>([](double x) -> double { return 1.0 / std::sqrt(x); })},
+        {"pow3.5", scalar_func_apply<double>([](double x) -> double { return std::pow(x, 3.5); })},
+        {"pow13", scalar_func_apply<double>([](double x) -> double { return std::pow(x, 13); })},
+    };
+
+    // Exponent, coordinates and divisor per element
+    registry.fx_2arg("std_fx1") = {
+        {"pow", scalar_func2_apply<float>([](float x, float y) -> float { return std::pow(x, y); })},
+        {"atan2", scalar_func2_apply<float>([](float x, float y) -> float { return std::atan2(x, y); })},
+        {"hypot", scalar_func2_apply<float>([](float x, float y) -> float { return std::hypot(x, y); })},
+        {"fmod", scalar_func2_apply<float>([](float x, float y) -> float { return std::fmod(x, y); })},
+    };
+
+    registry.dx_2arg("std_dx1") = {
+        {"pow", scalar_func2_apply<double>([](double x, double y) -> double { return std::pow(x, y); })},
+        {"atan2", scalar_func2_apply<double>([](double x, double y) -> double { return std::atan2(x, y); })},
+        {"hypot", scalar_func2_apply<double>([](double x, double y) -> double { return std::hypot(x, y); })},
+        {"fmod", scalar_func2_apply<double>([](double x, double y) -> double { return std::fmod(x, y); })},
+    };
+
+    // glibc's sincos, one range reduction for both
+    registry.fx_x2("std_fx1") = {
+        {"sincos", scalar_func_apply_x2<float>([](float x, float &s, float &c) { ::sincosf(x, &s, &c); })},
+    };
+
+    registry.dx_x2("std_dx1") = {
+        {"sincos", scalar_func_apply_x2<double>([](double x, double &s, double &c) { ::sincos(x, &s, &c); })},
+    };
+
+    // The cheapest of them again with the timed loop compiled per kernel, to measure the cost of the std::function
+    // per batch
+    registry.fx_loop("std-inline_fx1") = {
+        {"copy", scalar_loop_apply<float>([](float x) -> float { return x; })},
+        {"sqrt", scalar_loop_apply<float>([](float x) -> float { return std::sqrt(x); })},
+        {"rsqrt", scalar_loop_apply<float>([](float x) -> float { return 1.0 / std::sqrt(x); })},
+        {"exp", scalar_loop_apply<float>([](float x) -> float { return std::exp(x); })},
+        {"log", scalar_loop_apply<float>([](float x) -> float { return std::log(x); })},
+    };
+
+    registry.dx_loop("std-inline_dx1") = {
+        {"copy", scalar_loop_apply<double>([](double x) -> double { return x; })},
+        {"sqrt", scalar_loop_apply<double>([](double x) -> double { return std::sqrt(x); })},
+        {"rsqrt", scalar_loop_apply<double>([](double x) -> double { return 1.0 / std::sqrt(x); })},
+        {"exp", scalar_loop_apply<double>([](double x) -> double { return std::exp(x); })},
+        {"log", scalar_loop_apply<double>([](double x) -> double { return std::log(x); })},
+    };
+}
+
+static const bool registered = register_library(add_tables);
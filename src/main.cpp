@@ -1,36 +1,78 @@
 #include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
 #include <cmath>
 #include <complex>
 #include <cstddef>
 #include <cstdio>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
 #include <functional>
 #include <iomanip>
 #include <ios>
 #include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <optional>
 #include <set>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <toml.hpp>
 #include <tuple>
 #include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 #include <Eigen/Core>
 #include <baobzi.hpp>
 #include <boost/math/special_functions.hpp>
+#include <boost/version.hpp>
 #include <gsl/gsl_sf.h>
-#include <sctl.hpp>
+#include <gsl/gsl_version.h>
 #include <sleef.h>
-#include <unsupported/Eigen/SpecialFunctions>
 #include <vectorclass.h>
-#include <vectormath_exp.h>
-#include <vectormath_hyp.h>
-#include <vectormath_trig.h>
+
+#include "accuracy.hpp"
+#include "arena.hpp"
+#include "compare.hpp"
+#include "entry_spec.hpp"
+#include "input_dist.hpp"
+#include "kernels.hpp"
+#include "leaf_table.hpp"
+#include "perf_counters.hpp"
+#include "remez.hpp"
+#include "topology.hpp"
 
 #include <dlfcn.h>
+#include <elf.h>
 #include <gnu/libc-version.h>
+#include <link.h>
+#include <pthread.h>
+#include <sched.h>
 #include <time.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+
+#ifndef SF_CXX_FLAGS
+#define SF_CXX_FLAGS "unknown"
+#endif
+#ifndef SF_SCTL_VERSION
+#define SF_SCTL_VERSION "unknown"
+#endif
+#ifndef SF_BAOBZI_VERSION
+#define SF_BAOBZI_VERSION "unknown"
+#endif
 
 struct timespec get_wtime() {
     struct timespec ts;
@@ -42,79 +84,225 @@ double get_wtime_diff(const struct timespec *ts, const struct timespec *tf) {
     return (tf->tv_sec - ts->tv_sec) + (tf->tv_nsec - ts->tv_nsec) * 1E-9;
 }
 
-class Params {
-  public:
-    std::pair<double, double> domain{0.0, 1.0};
-};
+// Time stamp counter. It ticks at a constant rate, so cycles/eval from it are reference (nominal) cycles.
+inline std::uint64_t get_cycles() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
 
-typedef std::complex<double> cdouble;
-typedef sctl::Vec<double, 4> sctl_dx4;
-typedef sctl::Vec<double, 8> sctl_dx8;
+// Nearest rank percentile of a non-empty sample, p in [0, 1]
+double percentile(std::vector<double> vals, double p) {
+    std::sort(vals.begin(), vals.end());
+    const long rank = std::lround(std::ceil(p * vals.size())) - 1;
+    return vals[std::clamp<long>(rank, 0, vals.size() - 1)];
+}
 
-typedef sctl::Vec<float, 8> sctl_fx8;
-typedef sctl::Vec<float, 16> sctl_fx16;
+// Sample standard deviation
+double stddev(const std::vector<double> &vals) {
+    if (vals.size() < 2)
+        return 0.0;
+    const double mean = std::accumulate(vals.begin(), vals.end(), 0.0) / vals.size();
+    double var = 0.0;
+    for (auto v : vals)
+        var += (v - mean) * (v - mean);
+    return std::sqrt(var / (vals.size() - 1));
+}
 
-typedef std::function<double(double)> fun_dx1;
-typedef std::function<std::pair<cdouble, cdouble>(cdouble)> fun_cdx1_x2;
+// Split [0, N) into n_threads contiguous slices with boundaries on multiples of `block`, so each slice stays aligned
+// and a whole number of vector widths long. Returns the [start, end) of slice i_thread.
+std::pair<std::size_t, std::size_t> thread_slice(std::size_t N, int n_threads, int i_thread, std::size_t block = 64) {
+    const std::size_t n_blocks = (N + block - 1) / block;
+    const std::size_t start = std::min(N, (n_blocks * i_thread / n_threads) * block);
+    const std::size_t end = std::min(N, (n_blocks * (i_thread + 1) / n_threads) * block);
+    return {start, end};
+}
 
-template <class Real>
-using multi_eval_func = std::function<void(const Real *, Real *, size_t)>;
+// The CPUs in the affinity mask of the process, ascending. Offline CPUs, gaps in the ids and cpuset limits all show.
+std::vector<int> allowed_cpus() {
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed))
+        throw std::runtime_error(std::string("sched_getaffinity failed: ") + std::strerror(errno));
+    std::vector<int> res;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        if (CPU_ISSET(cpu, &allowed))
+            res.push_back(cpu);
+    return res;
+}
 
-template <class Real, int VecLen, class F>
-std::function<void(const Real *, Real *, size_t)> sctl_apply(const F &f) {
-    static const auto fn = [f](const Real *vals, Real *res, size_t N) {
-        using Vec = sctl::Vec<Real, VecLen>;
-        for (size_t i = 0; i < N; i += VecLen) {
-            Vec v = Vec::LoadAligned(vals + i);
-            f(v).StoreAligned(res + i);
-        }
-    };
-    return fn;
+// Pin the calling thread to exactly `cpu`. Returns the error of pthread_setaffinity_np, 0 on success.
+int pin_thread(int cpu) {
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(cpu, &cpuset);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
 }
 
-template <class VEC_T, class Real, class F>
-std::function<void(const Real *, Real *, size_t)> vec_func_apply(const F &f) {
-    static const auto fn = [f](const Real *vals, Real *res, size_t N) {
-        for (size_t i = 0; i < N; i += VEC_T::size()) {
-            VEC_T x;
-            x.load_a(vals + i);
-            VEC_T y = f(x);
-            y.store_a(res + i);
-        }
-    };
-    return fn;
+// CPU worker i_thread is pinned to: cpus in pinning order, or the allowed CPUs in ascending order if there are none.
+// -1 if there are fewer of them than workers.
+int worker_cpu(const std::vector<int> &cpus, int i_thread) {
+    if (!cpus.empty())
+        return i_thread < int(cpus.size()) ? cpus[i_thread] : -1;
+    const std::vector<int> allowed = allowed_cpus();
+    return i_thread < int(allowed.size()) ? allowed[i_thread] : -1;
 }
 
-template <class Real, class F>
-std::function<void(const Real *, Real *, size_t)> scalar_func_apply(const F &f) {
-    static const auto fn = [f](const Real *vals, Real *res, size_t N) {
-        for (size_t i = 0; i < N; i++)
-            res[i] = f(vals[i]);
-    };
-    return fn;
+// Run eval(start, end) on n_threads pinned workers, one slice of [0, N) each, each on a CPU of its own within the
+// affinity mask of the process; throws if there aren't enough or a worker can't be pinned. Workers spin until all of
+// them are ready, so the timed regions overlap. Returns the time each worker spent in eval. With `perf`, each worker
+// counts its events around eval alone, leaving out thread start-up and the spin, and their sum is added to `counts`.
+template <typename F>
+std::vector<double> run_threaded(const std::vector<int> &cpus, int n_threads, std::size_t N, const F &eval,
+                                 const PerfCounters *perf = nullptr,
+                                 std::vector<std::pair<std::string, double>> *counts = nullptr) {
+    const std::vector<int> allowed = allowed_cpus();
+    std::vector<int> thread_cpu(n_threads);
+    for (int i_thread = 0; i_thread < n_threads; ++i_thread) {
+        thread_cpu[i_thread] = worker_cpu(cpus, i_thread);
+        if (!std::binary_search(allowed.begin(), allowed.end(), thread_cpu[i_thread]))
+            throw std::runtime_error(
+                thread_cpu[i_thread] < 0
+                    ? std::to_string(n_threads) + " workers, but the process may run on " +
+                          std::to_string(allowed.size()) + " CPUs"
+                    : "CPU " + std::to_string(thread_cpu[i_thread]) + " is outside the affinity mask of the process");
+    }
+
+    std::vector<double> thread_eval_time(n_threads);
+    std::vector<std::vector<std::pair<std::string, double>>> thread_counts(n_threads);
+    std::vector<int> pin_error(n_threads);
+    std::vector<std::thread> workers;
+    std::atomic<int> n_ready{0};
+    for (int i_thread = 0; i_thread < n_threads; ++i_thread) {
+        workers.emplace_back([&, i_thread]() {
+            pin_error[i_thread] = pin_thread(thread_cpu[i_thread]);
+            const auto [start, end] = thread_slice(N, n_threads, i_thread);
+            std::optional<PerfCounters> counters;
+            if (perf)
+                counters.emplace(perf->names(), false);
+            n_ready++;
+            while (n_ready.load() < n_threads)
+                ;
+
+            if (counters)
+                counters->start();
+            const struct timespec st = get_wtime();
+            eval(start, end);
+            if (counters)
+                counters->disable();
+            const struct timespec ft = get_wtime();
+            thread_eval_time[i_thread] = get_wtime_diff(&st, &ft);
+            if (counters)
+                thread_counts[i_thread] = counters->read_counts();
+        });
+    }
+    for (auto &worker : workers)
+        worker.join();
+    for (int i_thread = 0; i_thread < n_threads; ++i_thread)
+        if (pin_error[i_thread])
+            throw std::runtime_error("Can't pin a worker to CPU " + std::to_string(thread_cpu[i_thread]) + ": " +
+                                     std::strerror(pin_error[i_thread]));
+
+    if (counts)
+        for (const auto &worker_counts : thread_counts)
+            PerfCounters::accumulate(*counts, worker_counts);
+    return thread_eval_time;
 }
 
-extern "C" {
-void hank103_(double _Complex *, double _Complex *, double _Complex *, int *);
-void fort_bessel_jn_(int *, double *, double *);
-void fort_bessel_yn_(int *, double *, double *);
+// 1, 2, 4, ... up to and including max_threads
+std::vector<int> get_thread_counts(int max_threads) {
+    std::vector<int> res;
+    for (int n_threads = 1; n_threads < max_threads; n_threads *= 2)
+        res.push_back(n_threads);
+    res.push_back(max_threads);
+    return res;
 }
 
+class Params {
+  public:
+    std::pair<double, double> domain{0.0, 1.0};
+    bool user_domain = false; // set from the config, takes precedence over the domain of a library's table
+    std::pair<double, double> domain2{0.0, 1.0}; // of the second argument, two-argument functions only
+    std::vector<double> cutoffs; // branch points of common implementations, for the `cutoffs` input distribution
+};
+
+class RunOptions {
+  public:
+    int n_threads = 0;            // 0: run on the calling thread, otherwise number of pinned worker threads
+    std::size_t n_accuracy = 0;   // number of inputs checked against the high precision reference, 0 to skip
+    int n_warmup = 0;             // untimed passes before the first sample
+    int n_samples = 1;            // independent timed passes, the median is reported
+    bool cycles = false;          // also read the time stamp counter around each sample
+    PerfCounters *perf = nullptr; // hardware counters around the timed samples, if requested
+    const InputDist *inputs = nullptr; // distribution of real inputs over the domain, uniform if not set
+    bool sorted = false;               // real inputs in ascending order
+    bool compare_sorted = false;       // also time every real entry on its inputs sorted, see BenchResult
+    const Arena *arena = nullptr;      // pre-faulted input and result buffers, otherwise allocated per entry
+    std::vector<int> cpus;             // worker i is pinned to cpus[i % cpus.size()], CPU i if empty
+    const Topology *topology = nullptr; // NUMA nodes of the worker CPUs
+
+    // Entry filters, empty means everything. Entries are labeled <library>_<precision><width>, e.g. sleef_dx8.
+    std::set<std::string> libraries;
+    std::set<std::string> precisions; // "f", "d" or "cd"
+    std::set<int> vector_widths;      // entries with an unspecified width (eigen_dxx) always pass
+
+    bool enabled(const std::string &library_prefix) const {
+        const EntrySpec spec(library_prefix);
+        if (!libraries.empty() && !libraries.count(spec.base_library()))
+            return false;
+        if (!precisions.empty() && !precisions.count(spec.precision))
+            return false;
+        if (!vector_widths.empty() && spec.width && !vector_widths.count(spec.width))
+            return false;
+        return true;
+    }
+};
+
 template <typename VAL_T>
 class BenchResult {
   public:
-    Eigen::VectorX<VAL_T> res;
+    std::size_t n_res = 0; // number of results, 0 if the entry didn't run
+    VAL_T mean = 0.0;      // of the results
     double eval_time = 0.0;
     std::string label;
+    std::string name;
+    std::string library_prefix;
     std::size_t n_evals;
     Params params;
+    int n_threads = 0; // 0: evaluated on the calling thread, otherwise number of pinned worker threads
+    std::vector<double> thread_eval_time;
+    std::vector<std::size_t> thread_n_evals;
+    std::vector<std::pair<int, double>> node_Mevals; // (NUMA node, Mevals/s of its workers), on multi-node machines
+    std::vector<double> sample_times; // eval_time is their median
+    std::uint64_t eval_cycles = 0;    // TSC ticks of the median sample, if requested
+    std::vector<std::pair<std::string, double>> counters; // perf event counts per sample, mean over the samples
+    std::optional<ErrorStats> errors;
+    bool is_latency = false; // n_evals dependent calls rather than independent evaluations
+    double setup_time = 0.0; // one-time cost outside of the timed samples, e.g. building tables
+    std::optional<double> dispatch_overhead; // ns/eval the type-erased entry of the kernel spends more, -inline only
+    std::optional<double> sorted_Mevals;     // on the same inputs in ascending order, with --order=compare
+    std::optional<double> fused_speedup;     // time of this over the library's fused entry of the key, -separate only
+    std::optional<double> native_speedup; // time of the library's native double entry over this, -mixed/-refined only
+    double bytes_per_eval = 0.0;             // of inputs and results, what a memory bound entry has to move
+    std::optional<double> bw_fraction;       // throughput over the stream_copy bandwidth bound, with --roofline
+    std::optional<double> peak_fma_per_eval; // FMAs fma_peak retires in the time of one evaluation, with --roofline
 
     BenchResult(const std::string &label_) : label(label_){};
     BenchResult(const std::string &label_, std::size_t size, std::size_t n_evals_, Params params_)
-        : res(size), label(label_), n_evals(n_evals_), params(params_){};
+        : n_res(size), label(label_), n_evals(n_evals_), params(params_){};
 
-    VAL_T &operator[](int i) { return res[i]; }
     double Mevals() const { return n_evals / eval_time / 1E6; }
+    double ns_per_call() const { return eval_time / n_evals * 1E9; }
+    double thread_Mevals(int i) const { return thread_n_evals[i] / thread_eval_time[i] / 1E6; }
+    double cycles_per_eval() const { return double(eval_cycles) / n_evals; }
+    std::optional<double> counter(const std::string &event) const {
+        for (const auto &[name, count] : counters)
+            if (name == event)
+                return count;
+        return std::nullopt;
+    }
 
     template <typename T>
     friend std::ostream &operator<<(std::ostream &, const BenchResult<T> &);
@@ -122,239 +310,959 @@ class BenchResult {
 
 template <typename VAL_T>
 std::ostream &operator<<(std::ostream &os, const BenchResult<VAL_T> &br) {
-    VAL_T mean = 0.0;
-    for (const auto &v : br.res)
-        mean += v;
-    mean /= br.res.size();
-
     using std::left;
     using std::setw;
-    if (br.res.size()) {
+    if (br.n_res) {
         os.precision(6);
-        os << left << setw(25) << br.label + ": " << left << setw(15) << br.Mevals();
+        os << left << setw(25) << br.label + ": " << left << setw(15)
+           << (br.is_latency ? br.ns_per_call() : br.Mevals());
         os.precision(15);
-        os << left << setw(15) << mean << left << setw(5) << " ";
+        os << left << setw(15) << br.mean << left << setw(5) << " ";
         os.precision(5);
-        os << "[" << br.params.domain.first << ", " << br.params.domain.second << "]" << std::endl;
+        os << "[" << br.params.domain.first << ", " << br.params.domain.second << "]";
+        if (br.n_threads) {
+            double thr_min = br.thread_Mevals(0), thr_max = thr_min, thr_mean = 0.0;
+            for (int i = 0; i < br.n_threads; ++i) {
+                thr_min = std::min(thr_min, br.thread_Mevals(i));
+                thr_max = std::max(thr_max, br.thread_Mevals(i));
+                thr_mean += br.thread_Mevals(i) / br.n_threads;
+            }
+            os.precision(6);
+            os << "    threads: " << left << setw(4) << br.n_threads << "per-thread: " << thr_mean << " [" << thr_min
+               << ", " << thr_max << "]";
+        }
+        if (!br.node_Mevals.empty()) {
+            os.precision(6);
+            os << "    per-node:";
+            for (const auto &[node, Mevals] : br.node_Mevals)
+                os << " " << node << ": " << Mevals;
+        }
+        if (br.sample_times.size() > 1) {
+            os.precision(4);
+            os << "    samples: " << left << setw(4) << br.sample_times.size()
+               << "t_min/med/p95: " << percentile(br.sample_times, 0.0) << " / " << br.eval_time << " / "
+               << percentile(br.sample_times, 0.95) << " s"
+               << "  sd: " << 100 * stddev(br.sample_times) / br.eval_time << "%";
+        }
+        if (br.eval_cycles) {
+            os.precision(4);
+            os << "    cycles/eval: " << br.cycles_per_eval();
+        }
+        if (!br.counters.empty()) {
+            os.precision(4);
+            const auto cycles = br.counter("cycles"), instructions = br.counter("instructions");
+            if (cycles && instructions)
+                os << "    ipc: " << *instructions / *cycles;
+            os << "    per eval:";
+            for (const auto &[name, count] : br.counters)
+                os << " " << name << " " << count / br.n_evals;
+        }
+        if (br.setup_time) {
+            os.precision(4);
+            os << "    setup: " << br.setup_time * 1E3 << " ms";
+        }
+        if (br.dispatch_overhead) {
+            os.precision(3);
+            os << "    dispatch: " << *br.dispatch_overhead << " ns/eval";
+        }
+        if (br.sorted_Mevals) {
+            os.precision(4);
+            os << "    sorted: " << *br.sorted_Mevals << " (x" << *br.sorted_Mevals / br.Mevals() << ")";
+        }
+        if (br.fused_speedup) {
+            os.precision(3);
+            os << "    fused: x" << *br.fused_speedup;
+        }
+        if (br.native_speedup) {
+            os.precision(3);
+            os << "    vs native: x" << *br.native_speedup;
+        }
+        if (br.bw_fraction) {
+            os.precision(3);
+            os << "    roofline: bw " << *br.bw_fraction << " fma/eval " << *br.peak_fma_per_eval;
+        }
+        if (br.errors) {
+            os.precision(3);
+            os << "    max_ulp: " << left << setw(10) << br.errors->max_ulp << "rms_ulp: " << left << setw(10)
+               << br.errors->rms_ulp << "max_rel: " << left << setw(10) << br.errors->max_rel;
+        }
+        os << std::endl;
     }
     return os;
 }
 
+// Forwards everything to `os`, keeps a record of each benchmark entry for the summaries printed after the runs, and
+// optionally writes the records as CSV and/or JSON lines with a metadata header
+class BenchLog {
+  public:
+    class Record {
+      public:
+        std::string label;
+        std::string name;
+        EntrySpec spec;
+        std::pair<double, double> domain;
+        std::size_t n_eval;
+        std::size_t n_evals;
+        int n_threads;
+        bool is_latency;
+        double eval_time;
+        double Mevals;
+        std::vector<double> thread_Mevals;
+        std::vector<std::pair<int, double>> node_Mevals;
+        std::vector<double> sample_times;
+        double cycles_per_eval;
+        std::vector<std::pair<std::string, double>> counters_per_eval;
+        std::optional<ErrorStats> errors;
+        double setup_time = 0.0;
+        std::optional<double> dispatch_overhead;
+        std::optional<double> sorted_Mevals;
+        std::optional<double> fused_speedup;
+        std::optional<double> native_speedup;
+        std::optional<double> bw_fraction;
+        std::optional<double> peak_fma_per_eval;
+    };
+    typedef std::vector<std::pair<std::string, std::string>> Metadata;
+
+    std::ostream &os;
+    std::size_t n_eval = 0; // length of the input vector of the current run set
+    std::vector<Record> records;
+
+    BenchLog(std::ostream &os_) : os(os_){};
+
+    void open_csv(const std::string &fname, const Metadata &metadata) {
+        csv.open(fname);
+        for (const auto &[key, value] : metadata)
+            csv << "# " << key << ": " << value << "\n";
+        csv << "label,function,library,precision,vector_width,domain_lower,domain_upper,n_eval,n_evals,n_threads,"
+               "mode,eval_time,Mevals,ns_per_eval,n_samples,t_min,t_p95,t_stddev,cycles_per_eval,max_ulp,rms_ulp,"
+               "max_rel,rms_rel,setup_time,dispatch_overhead,sorted_Mevals,fused_speedup,"
+               "native_speedup,bw_fraction,peak_fma_per_eval,node_Mevals,counters_per_eval\n";
+    }
+
+    void open_json(const std::string &fname, const Metadata &metadata) {
+        json.open(fname);
+        json << "{\"metadata\": {";
+        for (std::size_t i = 0; i < metadata.size(); ++i)
+            json << (i ? ", " : "") << quote(metadata[i].first) << ": " << quote(metadata[i].second);
+        json << "}}\n";
+    }
+
+    template <typename T>
+    BenchLog &operator<<(const T &x) {
+        os << x;
+        return *this;
+    }
+
+    template <typename VAL_T>
+    BenchLog &operator<<(const BenchResult<VAL_T> &br) {
+        os << br;
+        if (!br.n_res)
+            return *this;
+
+        Record rec{br.label,     br.name,         EntrySpec(br.library_prefix), br.params.domain, n_eval,
+                   br.n_evals,   br.n_threads,    br.is_latency,                br.eval_time,     br.Mevals(),
+                   {},           br.node_Mevals,  br.sample_times,              br.cycles_per_eval(), {},
+                   br.errors};
+        rec.setup_time = br.setup_time;
+        rec.dispatch_overhead = br.dispatch_overhead;
+        rec.sorted_Mevals = br.sorted_Mevals;
+        rec.fused_speedup = br.fused_speedup;
+        rec.native_speedup = br.native_speedup;
+        rec.bw_fraction = br.bw_fraction;
+        rec.peak_fma_per_eval = br.peak_fma_per_eval;
+        for (int i = 0; i < br.n_threads; ++i)
+            rec.thread_Mevals.push_back(br.thread_Mevals(i));
+        for (const auto &[name, count] : br.counters)
+            rec.counters_per_eval.push_back({name, count / br.n_evals});
+        if (csv.is_open())
+            write_csv(rec);
+        if (json.is_open())
+            write_json(rec);
+        records.push_back(rec);
+        return *this;
+    }
+
+  private:
+    std::ofstream csv;
+    std::ofstream json;
+
+    // JSON has no representation of inf/nan
+    static std::string number(double x) {
+        if (!std::isfinite(x))
+            return "null";
+        std::ostringstream ss;
+        ss.precision(10);
+        ss << x;
+        return ss.str();
+    }
+
+    static std::string quote(const std::string &str) {
+        std::string res = "\"";
+        for (char c : str) {
+            if (c == '"' || c == '\\')
+                res += '\\';
+            res += c;
+        }
+        return res + "\"";
+    }
+
+    void write_csv(const Record &rec) {
+        csv.precision(10);
+        csv << rec.label << "," << rec.name << "," << rec.spec.library << "," << rec.spec.precision << ","
+            << rec.spec.width << "," << rec.domain.first << "," << rec.domain.second << "," << rec.n_eval << ","
+            << rec.n_evals << "," << rec.n_threads << "," << (rec.is_latency ? "latency" : "throughput") << ","
+            << rec.eval_time << "," << rec.Mevals << "," << 1E3 / rec.Mevals << "," << rec.sample_times.size();
+        if (!rec.sample_times.empty())
+            csv << "," << percentile(rec.sample_times, 0.0) << "," << percentile(rec.sample_times, 0.95) << ","
+                << stddev(rec.sample_times);
+        else
+            csv << ",,,";
+        csv << "," << rec.cycles_per_eval;
+        if (rec.errors)
+            csv << "," << rec.errors->max_ulp << "," << rec.errors->rms_ulp << "," << rec.errors->max_rel << ","
+                << rec.errors->rms_rel;
+        else
+            csv << ",,,,";
+        csv << ",";
+        if (rec.setup_time)
+            csv << rec.setup_time;
+        csv << ",";
+        if (rec.dispatch_overhead)
+            csv << *rec.dispatch_overhead;
+        csv << ",";
+        if (rec.sorted_Mevals)
+            csv << *rec.sorted_Mevals;
+        csv << ",";
+        if (rec.fused_speedup)
+            csv << *rec.fused_speedup;
+        csv << ",";
+        if (rec.native_speedup)
+            csv << *rec.native_speedup;
+        csv << ",";
+        if (rec.bw_fraction)
+            csv << *rec.bw_fraction << "," << *rec.peak_fma_per_eval;
+        else
+            csv << ",";
+        csv << ",";
+        for (std::size_t i = 0; i < rec.node_Mevals.size(); ++i)
+            csv << (i ? ";" : "") << rec.node_Mevals[i].first << "=" << rec.node_Mevals[i].second;
+        csv << ",";
+        for (std::size_t i = 0; i < rec.counters_per_eval.size(); ++i)
+            csv << (i ? ";" : "") << rec.counters_per_eval[i].first << "=" << rec.counters_per_eval[i].second;
+        csv << "\n";
+    }
+
+    void write_json(const Record &rec) {
+        json << "{\"label\": " << quote(rec.label) << ", \"function\": " << quote(rec.name)
+             << ", \"library\": " << quote(rec.spec.library) << ", \"precision\": " << quote(rec.spec.precision)
+             << ", \"vector_width\": " << rec.spec.width << ", \"domain\": [" << number(rec.domain.first) << ", "
+             << number(rec.domain.second) << "], \"n_eval\": " << rec.n_eval << ", \"n_evals\": " << rec.n_evals
+             << ", \"n_threads\": " << rec.n_threads
+             << ", \"mode\": " << quote(rec.is_latency ? "latency" : "throughput")
+             << ", \"eval_time\": " << number(rec.eval_time) << ", \"Mevals\": " << number(rec.Mevals)
+             << ", \"ns_per_eval\": " << number(1E3 / rec.Mevals);
+        if (!rec.sample_times.empty()) {
+            json << ", \"samples\": [";
+            for (std::size_t i = 0; i < rec.sample_times.size(); ++i)
+                json << (i ? ", " : "") << number(rec.sample_times[i]);
+            json << "], \"t_min\": " << number(percentile(rec.sample_times, 0.0))
+                 << ", \"t_p95\": " << number(percentile(rec.sample_times, 0.95))
+                 << ", \"t_stddev\": " << number(stddev(rec.sample_times));
+        }
+        if (rec.cycles_per_eval)
+            json << ", \"cycles_per_eval\": " << number(rec.cycles_per_eval);
+        if (!rec.thread_Mevals.empty()) {
+            json << ", \"thread_Mevals\": [";
+            for (std::size_t i = 0; i < rec.thread_Mevals.size(); ++i)
+                json << (i ? ", " : "") << number(rec.thread_Mevals[i]);
+            json << "]";
+        }
+        if (!rec.node_Mevals.empty()) {
+            json << ", \"node_Mevals\": {";
+            for (std::size_t i = 0; i < rec.node_Mevals.size(); ++i)
+                json << (i ? ", " : "") << quote(std::to_string(rec.node_Mevals[i].first)) << ": "
+                     << number(rec.node_Mevals[i].second);
+            json << "}";
+        }
+        if (rec.errors)
+            json << ", \"max_ulp\": " << number(rec.errors->max_ulp) << ", \"rms_ulp\": "
+                 << number(rec.errors->rms_ulp) << ", \"max_rel\": " << number(rec.errors->max_rel)
+                 << ", \"rms_rel\": " << number(rec.errors->rms_rel);
+        if (rec.setup_time)
+            json << ", \"setup_time\": " << number(rec.setup_time);
+        if (rec.dispatch_overhead)
+            json << ", \"dispatch_overhead\": " << number(*rec.dispatch_overhead);
+        if (rec.sorted_Mevals)
+            json << ", \"sorted_Mevals\": " << number(*rec.sorted_Mevals);
+        if (rec.fused_speedup)
+            json << ", \"fused_speedup\": " << number(*rec.fused_speedup);
+        if (rec.native_speedup)
+            json << ", \"native_speedup\": " << number(*rec.native_speedup);
+        if (rec.bw_fraction)
+            json << ", \"bw_fraction\": " << number(*rec.bw_fraction)
+                 << ", \"peak_fma_per_eval\": " << number(*rec.peak_fma_per_eval);
+        if (!rec.counters_per_eval.empty()) {
+            json << ", \"counters_per_eval\": {";
+            for (std::size_t i = 0; i < rec.counters_per_eval.size(); ++i)
+                json << (i ? ", " : "") << quote(rec.counters_per_eval[i].first) << ": "
+                     << number(rec.counters_per_eval[i].second);
+            json << "}";
+        }
+        json << "}\n";
+    }
+};
+
+// One line per entry with its cost in ns per evaluation for each input length, in the order the lengths were run
+void print_sweep(std::ostream &os, const std::vector<BenchLog::Record> &records) {
+    std::vector<std::size_t> sizes;
+    std::vector<std::string> labels;
+    std::unordered_map<std::string, std::unordered_map<std::size_t, double>> ns_per_eval;
+    for (const auto &rec : records) {
+        if (rec.is_latency)
+            continue;
+        const std::string label = rec.n_threads ? rec.label + "@" + std::to_string(rec.n_threads) : rec.label;
+        if (std::find(sizes.begin(), sizes.end(), rec.n_eval) == sizes.end())
+            sizes.push_back(rec.n_eval);
+        if (!ns_per_eval.count(label))
+            labels.push_back(label);
+        ns_per_eval[label][rec.n_eval] = 1E3 / rec.Mevals;
+    }
+
+    using std::left;
+    using std::setw;
+    os << "ns/eval vs. input length\n" << left << setw(25) << "N";
+    for (auto n : sizes)
+        os << left << setw(10) << n;
+    os << "\n";
+
+    os.precision(4);
+    for (const auto &label : labels) {
+        os << left << setw(25) << label + ": ";
+        for (auto n : sizes) {
+            if (ns_per_eval[label].count(n))
+                os << left << setw(10) << ns_per_eval[label][n];
+            else
+                os << left << setw(10) << "-";
+        }
+        os << "\n";
+    }
+}
+
 template <typename VAL_T>
-Eigen::VectorX<VAL_T> transform_domain(const Eigen::VectorX<VAL_T> &vals, double lower, double upper) {
+void transform_domain(const Eigen::VectorX<VAL_T> &vals, double lower, double upper, VAL_T *out) {
     VAL_T delta = upper - lower;
-    return vals.array() * delta + lower;
+    Eigen::Map<Eigen::VectorX<VAL_T>>(out, vals.size()) = vals.array() * delta + lower;
+}
+
+// Time eval(start, end) over [0, N), either on the calling thread (n_threads == 0) or split across n_threads pinned
+// workers, in which case the slowest worker sets the time of a sample. After opts.n_warmup untimed passes, which
+// also fault in the result pages, opts.n_samples passes are timed and the median one is reported.
+template <typename VAL_T, typename F>
+void time_eval(BenchResult<VAL_T> &res, std::size_t N, size_t Nrepeat, const RunOptions &opts, const F &eval) {
+    const int n_threads = opts.n_threads;
+    for (int i = 0; i < opts.n_warmup; ++i) {
+        if (n_threads == 0)
+            eval(0, N);
+        else
+            run_threaded(opts.cpus, n_threads, N, eval);
+    }
+
+    std::vector<std::vector<double>> sample_thread_times;
+    std::vector<std::uint64_t> sample_cycles;
+    const int n_samples = std::max(1, opts.n_samples);
+    // The calling thread's counters cover all samples on it; threaded samples add up what each worker counted
+    if (opts.perf && n_threads == 0)
+        opts.perf->start();
+    for (int i_sample = 0; i_sample < n_samples; ++i_sample) {
+        if (n_threads == 0) {
+            const struct timespec st = get_wtime();
+            const std::uint64_t cst = opts.cycles ? get_cycles() : 0;
+            eval(0, N);
+            const std::uint64_t cft = opts.cycles ? get_cycles() : 0;
+            const struct timespec ft = get_wtime();
+            res.sample_times.push_back(get_wtime_diff(&st, &ft));
+            sample_cycles.push_back(cft - cst);
+        } else {
+            sample_thread_times.push_back(run_threaded(opts.cpus, n_threads, N, eval, opts.perf, &res.counters));
+            const auto &thread_times = sample_thread_times.back();
+            res.sample_times.push_back(*std::max_element(thread_times.begin(), thread_times.end()));
+        }
+    }
+    if (opts.perf) {
+        if (n_threads == 0)
+            res.counters = opts.perf->stop();
+        for (auto &[name, count] : res.counters)
+            count /= n_samples;
+    }
+
+    std::vector<std::size_t> order(res.sample_times.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&res](auto a, auto b) { return res.sample_times[a] < res.sample_times[b]; });
+    const std::size_t i_median = order[(order.size() - 1) / 2];
+    res.eval_time = res.sample_times[i_median];
+
+    if (n_threads == 0) {
+        res.eval_cycles = sample_cycles[i_median];
+        return;
+    }
+
+    res.n_threads = n_threads;
+    res.thread_eval_time = sample_thread_times[i_median];
+    for (int i = 0; i < n_threads; ++i) {
+        const auto [start, end] = thread_slice(N, n_threads, i);
+        res.thread_n_evals.push_back((end - start) * Nrepeat);
+    }
+
+    // The workers of a node finish together when its slowest one is done
+    if (opts.topology && opts.topology->n_nodes() > 1) {
+        std::map<int, std::pair<std::size_t, double>> nodes;
+        for (int i = 0; i < n_threads; ++i) {
+            auto &[n_evals, time] = nodes[opts.topology->node_of(worker_cpu(opts.cpus, i))];
+            n_evals += res.thread_n_evals[i];
+            time = std::max(time, res.thread_eval_time[i]);
+        }
+        for (const auto &[node, evals_time] : nodes)
+            res.node_Mevals.push_back({node, evals_time.first / evals_time.second / 1E6});
+    }
+}
+
+// Put each worker's slice of the inputs and results on the worker's NUMA node, outside of the timed region. Fresh
+// buffers are first touched by the worker that owns the slice, the pre-faulted arena has its slices migrated.
+template <typename VAL_T>
+void place_slices(VAL_T *vals, VAL_T *res, std::size_t N, int n_out, bool prefaulted, const RunOptions &opts) {
+    if (!prefaulted) {
+        run_threaded(opts.cpus, opts.n_threads, N, [&](std::size_t start, std::size_t end) {
+            std::fill(vals + start, vals + end, VAL_T(0));
+            std::fill(res + start * n_out, res + end * n_out, VAL_T(0));
+        });
+        return;
+    }
+    if (!opts.topology || opts.topology->n_nodes() < 2)
+        return;
+    for (int i = 0; i < opts.n_threads; ++i) {
+        const auto [start, end] = thread_slice(N, opts.n_threads, i);
+        const int node = opts.topology->node_of(worker_cpu(opts.cpus, i));
+        if (end > start) {
+            Topology::move_to_node(vals + start, (end - start) * sizeof(VAL_T), node);
+            Topology::move_to_node(res + start * n_out, (end - start) * n_out * sizeof(VAL_T), node);
+        }
+    }
+}
+
+// Two-argument functions against their references at (x, y)
+template <typename VAL_T>
+void check_accuracy2(BenchResult<VAL_T> &res, const std::string &name, const VAL_T *vals_x, const VAL_T *vals_y,
+                     const VAL_T *results, std::size_t N, std::size_t n_samples) {
+    const std::size_t stride = std::max<std::size_t>(1, N / n_samples);
+    std::vector<VAL_T> x, y, z;
+    for (std::size_t i = 0; i < N && x.size() < n_samples; i += stride) {
+        x.push_back(vals_x[i]);
+        y.push_back(vals_y[i]);
+        z.push_back(results[i]);
+    }
+
+    const std::vector<long double> *ref = reference_eval2(name, x, y);
+    if (ref)
+        res.errors = error_stats(z, *ref);
+}
+
+// Both outputs of a fused key against the references of its single output functions, as one set of errors
+template <typename VAL_T>
+void check_accuracy_x2(BenchResult<VAL_T> &res, const std::string &name, const VAL_T *vals, const VAL_T *results0,
+                       const VAL_T *results1, std::size_t N, std::size_t n_samples) {
+    if (!fused_outputs().count(name))
+        return;
+    const auto &[name0, name1] = fused_outputs().at(name);
+    const std::size_t stride = std::max<std::size_t>(1, N / n_samples);
+    std::vector<VAL_T> x, y0, y1;
+    for (std::size_t i = 0; i < N && x.size() < n_samples; i += stride) {
+        x.push_back(vals[i]);
+        y0.push_back(results0[i]);
+        y1.push_back(results1[i]);
+    }
+
+    const std::vector<long double> *ref0 = reference_eval(name0, x);
+    const std::vector<long double> *ref1 = reference_eval(name1, x);
+    if (!ref0 || !ref1)
+        return;
+    std::vector<long double> ref = *ref0;
+    ref.insert(ref.end(), ref1->begin(), ref1->end());
+    y0.insert(y0.end(), y1.begin(), y1.end());
+    res.errors = error_stats(y0, ref);
+}
+
+// Compare up to n_samples evenly strided results against the reference implementation of `name`, if there is one.
+// Complex entries are checked against 50 digit closed forms, and the Hankel functions against the Fortran hank103.
+template <typename VAL_T>
+void check_accuracy(BenchResult<VAL_T> &res, const std::string &name, const VAL_T *vals, const VAL_T *results,
+                    std::size_t N, std::size_t n_samples) {
+    const std::size_t stride = std::max<std::size_t>(1, N / n_samples);
+    if constexpr (std::is_floating_point_v<VAL_T>) {
+        std::vector<VAL_T> x, y;
+        for (std::size_t i = 0; i < N && x.size() < n_samples; i += stride) {
+            x.push_back(vals[i]);
+            y.push_back(results[i]);
+        }
+
+        const std::vector<long double> *ref = reference_eval(name, x);
+        if (ref)
+            res.errors = error_stats(y, *ref);
+    } else if constexpr (std::is_same_v<VAL_T, cdouble>) {
+        if (name != "hank103" && name != "hank106") {
+            std::vector<cdouble> z, y;
+            for (std::size_t i = 0; i < N && z.size() < n_samples; i += stride) {
+                z.push_back(vals[i]);
+                y.push_back(results[i]);
+            }
+            const std::vector<cdouble> *ref = reference_evalc(name, z);
+            if (ref)
+                res.errors = error_stats(y, *ref);
+            return;
+        }
+
+        std::vector<cdouble> y, ref;
+        for (std::size_t i = 0; i < N && y.size() < 2 * n_samples; i += stride) {
+            cdouble z = name == "hank106" ? hank106_ray_point(vals[i]) : vals[i], h0, h1;
+            int ifexpon = 1;
+            hank103_((double _Complex *)&z, (double _Complex *)&h0, (double _Complex *)&h1, &ifexpon);
+            y.insert(y.end(), {results[i * 2], results[i * 2 + 1]});
+            ref.insert(ref.end(), {h0, h1});
+        }
+        res.errors = error_stats(y, ref);
+    }
 }
 
 template <typename FUN_T, typename VAL_T>
 BenchResult<VAL_T>
 test_func(const std::string name, const std::string library_prefix, const std::unordered_map<std::string, FUN_T> funs,
-          std::unordered_map<std::string, Params> params, const Eigen::VectorX<VAL_T> &vals_in, size_t Nrepeat) {
+          std::unordered_map<std::string, Params> params, const Eigen::VectorX<VAL_T> &vals_in, size_t Nrepeat,
+          const RunOptions &opts = RunOptions()) {
     const std::string label = library_prefix + "_" + name;
-    if (!funs.count(name))
+    if (!funs.count(name) || !opts.enabled(library_prefix))
         return BenchResult<VAL_T>(label);
 
-    const Params &par = params[name];
-    Eigen::VectorX<VAL_T> vals = transform_domain(vals_in, par.domain.first, par.domain.second);
+    Params par = params[name];
+    constexpr bool soa = std::is_same_v<FUN_T, soa_eval_func_cdx_x2>;
+    constexpr bool loop = std::is_same_v<FUN_T, multi_eval_loop<VAL_T>>;
+    // Two real outputs, the first in resptr[0, N), the second in resptr[N, 2 N)
+    constexpr bool real_x2 = std::is_same_v<FUN_T, multi_eval_func_x2<VAL_T>>;
+    constexpr int n_out =
+        std::is_same_v<FUN_T, fun_cdx1_x2> || soa || std::is_same_v<FUN_T, eval_loop_cdx1_x2> || real_x2 ? 2 : 1;
+    // Two real arguments, x in inptr[0, N), y in inptr[N, 2 N), from the two halves of vals_in
+    constexpr bool two_arg = std::is_same_v<FUN_T, multi_eval_func2<VAL_T>>;
+    const std::size_t N = two_arg ? vals_in.size() / 2 : vals_in.size();
+    const std::size_t in_size = two_arg ? 2 * N : N;
+    size_t res_size = N * n_out;
+    size_t n_evals = N * Nrepeat;
+
+    // Inputs and results go to the arena when it's large enough, otherwise to buffers of this entry
+    Eigen::VectorX<VAL_T> own_vals, own_res;
+    const bool in_arena = opts.arena && opts.arena->fits(in_size * sizeof(VAL_T), res_size * sizeof(VAL_T));
+    if (!in_arena) {
+        own_vals.resize(in_size);
+        own_res.resize(res_size);
+    }
+    VAL_T *inptr = in_arena ? opts.arena->template input<VAL_T>() : own_vals.data();
+    VAL_T *resptr = in_arena ? opts.arena->template output<VAL_T>() : own_res.data();
+    const VAL_T *vals = inptr;
+    if (opts.n_threads) {
+        place_slices(inptr, resptr, N, real_x2 ? 1 : n_out, in_arena, opts);
+        if constexpr (real_x2)
+            place_slices(inptr, resptr + N, N, 1, in_arena, opts);
+        if constexpr (two_arg)
+            place_slices(inptr + N, resptr, N, 1, in_arena, opts);
+    }
+
+    if constexpr (std::is_floating_point_v<VAL_T>) {
+        // The distribution and order apply to x, y is uniform on its domain
+        Eigen::VectorX<VAL_T> u_x, u_y;
+        if constexpr (two_arg) {
+            u_x = vals_in.head(N);
+            u_y = vals_in.tail(N);
+            transform_domain(u_y, par.domain2.first, par.domain2.second, inptr + N);
+        }
+        const Eigen::VectorX<VAL_T> &u = two_arg ? u_x : vals_in;
+
+        const bool replay = opts.inputs && opts.inputs->kind == InputDist::TRACE;
+        bool in_place = false;
+        if constexpr (std::is_same_v<VAL_T, double> && !two_arg) {
+            // float64 traces long enough for the run are evaluated straight from the mapped file
+            in_place = replay && !opts.sorted && opts.inputs->trace_size() >= N;
+            if (in_place)
+                vals = opts.inputs->trace_data();
+        }
+        if (!in_place && opts.inputs)
+            opts.inputs->map(u, par.domain, par.cutoffs, inptr);
+        else if (!in_place)
+            transform_domain(u, par.domain.first, par.domain.second, inptr);
+        if (opts.sorted)
+            std::sort(inptr, inptr + N);
+        // Traces ignore the domain, so report the range they cover instead
+        if (replay && N) {
+            const auto [lo, hi] = std::minmax_element(vals, vals + N);
+            par.domain = {*lo, *hi};
+        }
+    } else {
+        transform_domain(vals_in, par.domain.first, par.domain.second, inptr);
+    }
 
-    size_t res_size = vals.size();
-    size_t n_evals = vals.size() * Nrepeat;
-    if constexpr (std::is_same_v<FUN_T, fun_cdx1_x2>)
-        res_size *= 2;
     BenchResult<VAL_T> res(label, res_size, n_evals, par);
-    VAL_T *resptr = res.res.data();
+    res.name = name;
+    res.library_prefix = library_prefix;
+    if (N)
+        res.bytes_per_eval = double(sizeof(VAL_T)) * (in_size + res_size) / N;
 
     const FUN_T &f = funs.at(name);
 
-    const struct timespec st = get_wtime();
-    for (long k = 0; k < Nrepeat; k++) {
-        if constexpr (std::is_same_v<FUN_T, fun_cdx1_x2>) {
-            for (std::size_t i = 0; i < vals.size(); ++i) {
-                std::tie(resptr[i * 2], resptr[i * 2 + 1]) = f(vals[i]);
-            }
-        } else if constexpr (std::is_same_v<FUN_T, std::shared_ptr<baobzi::Baobzi>>) {
-            (*f)(vals.data(), resptr, vals.size());
+    // Split real / imaginary buffers for the SoA entries, filled outside of the timed region. The results are
+    // interleaved back into (h0, h1) pairs afterwards, so they compare directly with the fun_cdx1_x2 entries.
+    std::vector<double> z_re, z_im, h0_re, h0_im, h1_re, h1_im;
+    if constexpr (soa) {
+        for (auto *buf : {&z_re, &z_im, &h0_re, &h0_im, &h1_re, &h1_im})
+            buf->resize(N);
+        for (std::size_t i = 0; i < N; ++i) {
+            z_re[i] = std::real(vals[i]);
+            z_im[i] = std::imag(vals[i]);
+        }
+    }
+
+    auto eval = [&](std::size_t i_start, std::size_t i_end) {
+        if constexpr (loop) {
+            // One call for all repeats, the loop is compiled into the kernel
+            f(vals + i_start, resptr + i_start * n_out, i_end - i_start, Nrepeat);
         } else {
-            f(vals.data(), resptr, vals.size());
+            for (long k = 0; k < Nrepeat; k++) {
+                if constexpr (std::is_same_v<FUN_T, fun_cdx1_x2>) {
+                    for (std::size_t i = i_start; i < i_end; ++i) {
+                        std::tie(resptr[i * 2], resptr[i * 2 + 1]) = f(vals[i]);
+                    }
+                } else if constexpr (real_x2) {
+                    f(vals + i_start, resptr + i_start, resptr + N + i_start, i_end - i_start);
+                } else if constexpr (two_arg) {
+                    f(vals + i_start, vals + N + i_start, resptr + i_start, i_end - i_start);
+                } else if constexpr (soa) {
+                    f(z_re.data() + i_start, z_im.data() + i_start, h0_re.data() + i_start, h0_im.data() + i_start,
+                      h1_re.data() + i_start, h1_im.data() + i_start, i_end - i_start);
+                } else {
+                    f(vals + i_start, resptr + i_start, i_end - i_start);
+                }
+            }
+        }
+    };
+    time_eval(res, N, Nrepeat, opts, eval);
+
+    if constexpr (soa) {
+        for (std::size_t i = 0; i < N; ++i) {
+            resptr[i * 2] = {h0_re[i], h0_im[i]};
+            resptr[i * 2 + 1] = {h1_re[i], h1_im[i]};
         }
     }
-    const struct timespec ft = get_wtime();
 
-    res.eval_time = get_wtime_diff(&st, &ft);
+    if (res_size)
+        res.mean = Eigen::Map<const Eigen::VectorX<VAL_T>>(resptr, res_size).mean();
+    if constexpr (real_x2) {
+        if (opts.n_accuracy)
+            check_accuracy_x2(res, name, vals, resptr, resptr + N, N, opts.n_accuracy);
+    } else if constexpr (two_arg) {
+        if (opts.n_accuracy)
+            check_accuracy2(res, name, vals, vals + N, resptr, N, opts.n_accuracy);
+    } else if (opts.n_accuracy) {
+        check_accuracy(res, name, vals, resptr, N, opts.n_accuracy);
+    }
 
     return res;
 }
 
-// https://eigen.tuxfamily.org/dox/group__CoeffwiseMathFunctions.html
-namespace OPS {
-enum OPS {
-    COS,
-    SIN,
-    TAN,
-    COSH,
-    SINH,
-    TANH,
-    EXP,
-    LOG,
-    LOG10,
-    POW35,
-    POW13,
-    ASIN,
-    ACOS,
-    ATAN,
-    ASINH,
-    ACOSH,
-    ATANH,
-    ERF,
-    ERFC,
-    LGAMMA,
-    DIGAMMA,
-    NDTRI,
-    SQRT,
-    RSQRT
-};
-}
+// Widest vector test_latency calls with, the size of its chain buffers
+constexpr int max_latency_width = 16;
 
-template <typename Real>
-BenchResult<Real> test_func(const std::string name, const std::string library_prefix,
-                            const std::unordered_map<std::string, OPS::OPS> funs,
-                            std::unordered_map<std::string, Params> params, const Eigen::VectorX<Real> &vals_in,
-                            size_t Nrepeat) {
+// Latency of a dependent chain of n_calls evaluations, where each output is remapped into the domain and fed back as
+// the next input. Vector maps get a full vector of `width` lanes per call, but only lane 0 carries the chain. The remap
+// and the call through the batch interface are included in the time; the `copy` entries measure that floor.
+template <typename FUN_T, typename VAL_T>
+BenchResult<VAL_T> test_latency(const std::string name, const std::string library_prefix,
+                                const std::unordered_map<std::string, FUN_T> funs,
+                                std::unordered_map<std::string, Params> params, const Eigen::VectorX<VAL_T> &vals_in,
+                                size_t n_calls, int width, const RunOptions &opts = RunOptions()) {
     const std::string label = library_prefix + "_" + name;
-    if (!funs.count(name))
-        return BenchResult<Real>(label);
+    if (!funs.count(name) || !opts.enabled(library_prefix))
+        return BenchResult<VAL_T>(label);
 
     const Params &par = params[name];
-    Eigen::VectorX<Real> x = transform_domain(vals_in, par.domain.first, par.domain.second);
+    const VAL_T lower = par.domain.first;
+    const VAL_T delta = par.domain.second - par.domain.first;
 
-    BenchResult<Real> res(label, x.size(), x.size() * Nrepeat, par);
+    BenchResult<VAL_T> res(label, 1, n_calls, par);
+    res.name = name;
+    res.library_prefix = library_prefix;
+    res.is_latency = true;
 
-    Eigen::VectorX<Real> &res_eigen = res.res;
+    if (width < 1 || width > max_latency_width)
+        throw std::invalid_argument("Latency of " + label + " needs 1 to " + std::to_string(max_latency_width) +
+                                    " lanes, got " + std::to_string(width));
+    alignas(64) VAL_T x[max_latency_width] = {}, y[max_latency_width] = {};
+    for (int i = 0; i < width; ++i)
+        x[i] = lower + delta * vals_in[i];
 
-    OPS::OPS OP = funs.at(name);
+    const FUN_T &f = funs.at(name);
     const struct timespec st = get_wtime();
+    for (size_t k = 0; k < n_calls; ++k) {
+        f(x, y, width);
 
-    for (long k = 0; k < Nrepeat; k++)
-        switch (OP) {
-        case OPS::COS:
-            res_eigen = x.array().cos();
-            break;
-        case OPS::SIN:
-            res_eigen = x.array().sin();
-            break;
-        case OPS::TAN:
-            res_eigen = x.array().tan();
-            break;
-        case OPS::COSH:
-            res_eigen = x.array().cosh();
-            break;
-        case OPS::SINH:
-            res_eigen = x.array().sinh();
-            break;
-        case OPS::TANH:
-            res_eigen = x.array().tanh();
-            break;
-        case OPS::EXP:
-            res_eigen = x.array().exp();
-            break;
-        case OPS::LOG:
-            res_eigen = x.array().log();
-            break;
-        case OPS::LOG10:
-            res_eigen = x.array().log10();
-            break;
-        case OPS::POW35:
-            res_eigen = x.array().pow(3.5);
-            break;
-        case OPS::POW13:
-            res_eigen = x.array().pow(13);
-            break;
-        case OPS::ASIN:
-            res_eigen = x.array().asin();
-            break;
-        case OPS::ACOS:
-            res_eigen = x.array().acos();
-            break;
-        case OPS::ATAN:
-            res_eigen = x.array().atan();
-            break;
-        case OPS::ASINH:
-            res_eigen = x.array().asinh();
-            break;
-        case OPS::ACOSH:
-            res_eigen = x.array().acosh();
-            break;
-        case OPS::ATANH:
-            res_eigen = x.array().atanh();
-            break;
-        case OPS::ERF:
-            res_eigen = x.array().erf();
-            break;
-        case OPS::ERFC:
-            res_eigen = x.array().erfc();
-            break;
-        case OPS::LGAMMA:
-            res_eigen = x.array().lgamma();
-            break;
-        case OPS::DIGAMMA:
-            res_eigen = x.array().digamma();
-            break;
-        case OPS::NDTRI:
-            res_eigen = x.array().ndtri();
-            break;
-        case OPS::SQRT:
-            res_eigen = x.array().sqrt();
-            break;
-        case OPS::RSQRT:
-            res_eigen = x.array().rsqrt();
-            break;
-        }
-
+        const VAL_T t = y[0] - std::floor(y[0]);
+        x[0] = (t >= 0 && t < 1) ? lower + delta * t : lower + delta * VAL_T(0.5);
+    }
     const struct timespec ft = get_wtime();
     res.eval_time = get_wtime_diff(&st, &ft);
+    res.mean = x[0];
 
     return res;
 }
 
+// Parameters of `name` for one table: its own domain, unless the config sets one
+template <typename FUN_T>
+std::unordered_map<std::string, Params> table_params(const KernelTable<FUN_T> &table, const std::string &name,
+                                                     std::unordered_map<std::string, Params> params) {
+    if (table.domains.count(name) && !params[name].user_domain)
+        params[name].domain = table.domains.at(name);
+    return params;
+}
+
+// ns/eval of the library's own entry that a "-inline", "-separate", "-mixed" or "-refined" entry mirrors, on the same
+// input length and thread count. The library's own entries run first.
+template <typename VAL_T>
+std::optional<double> mirrored_ns_per_eval(const BenchLog &out, const BenchResult<VAL_T> &res) {
+    const EntrySpec spec(res.library_prefix);
+    if (spec.variant().empty())
+        return std::nullopt;
+
+    std::string baseline = res.label;
+    baseline.erase(spec.base_library().size(), spec.library.size() - spec.base_library().size());
+    for (auto rec = out.records.rbegin(); rec != out.records.rend(); ++rec)
+        if (rec->label == baseline && rec->n_eval == out.n_eval && rec->n_threads == res.n_threads && !rec->is_latency)
+            return 1E3 / rec->Mevals;
+    return std::nullopt;
+}
+
+// Where an entry sits under the roofline of its precision, input length and thread count: the stream_copy bandwidth
+// and fma_peak rate, the highest of those over the tiers, from the roofline entries that ran first with --roofline.
+// Complex entries are held to the double references.
+template <typename VAL_T>
+void set_roofline(const BenchLog &out, BenchResult<VAL_T> &res) {
+    const EntrySpec spec(res.library_prefix);
+    const std::string precision = spec.precision == "f" ? "f" : "d";
+    double bytes_per_s = 0, fmas_per_s = 0;
+    for (const auto &rec : out.records) {
+        if (rec.spec.base_library() != "roofline" || rec.spec.precision != precision || rec.n_eval != out.n_eval ||
+            rec.n_threads != res.n_threads)
+            continue;
+        if (rec.name == "stream_copy")
+            bytes_per_s = std::max(bytes_per_s, rec.Mevals * 1E6 * 2 * (precision == "f" ? 4 : 8));
+        else if (rec.name == "fma_peak")
+            fmas_per_s = std::max(fmas_per_s, rec.Mevals * 1E6 * roofline_fma_chain);
+    }
+    if (!bytes_per_s || !fmas_per_s || spec.base_library() == "roofline")
+        return;
+    res.bw_fraction = res.Mevals() * 1E6 * res.bytes_per_eval / bytes_per_s;
+    res.peak_fma_per_eval = fmas_per_s / (res.Mevals() * 1E6);
+}
+
+// Throughput of `name` for every table of one function type, in registry order
+template <typename FUN_T, typename VAL_T>
+void run_tables(BenchLog &out, const std::string &name, const std::vector<KernelTable<FUN_T>> &tables,
+                const std::unordered_map<std::string, Params> &params, const Eigen::VectorX<VAL_T> &vals,
+                size_t Nrepeat, const RunOptions &opts) {
+    for (const auto &table : tables) {
+        if (opts.n_threads > 1 && table.single_threaded.count(name))
+            continue;
+        auto res = test_func(name, table.prefix, table.funs, table_params(table, name, params), vals, Nrepeat, opts);
+        if (table.setup_times.count(name))
+            res.setup_time = table.setup_times.at(name);
+        if (const auto mirrored = res.n_res ? mirrored_ns_per_eval(out, res) : std::nullopt) {
+            const std::string variant = EntrySpec(res.library_prefix).variant();
+            if (variant == "inline")
+                res.dispatch_overhead = *mirrored - res.ns_per_call();
+            else if (variant == "separate")
+                res.fused_speedup = res.ns_per_call() / *mirrored;
+            else if (variant == "mixed" || variant == "refined")
+                res.native_speedup = *mirrored / res.ns_per_call();
+        }
+        if (res.n_res)
+            set_roofline(out, res);
+        if constexpr (std::is_floating_point_v<VAL_T>) {
+            // Same values in order, so the difference is down to branches on the input (and prefetching of tables)
+            if (res.n_res && opts.compare_sorted) {
+                RunOptions sorted_opts = opts;
+                sorted_opts.sorted = true;
+                sorted_opts.n_accuracy = 0;
+                sorted_opts.perf = nullptr;
+                res.sorted_Mevals =
+                    test_func(name, table.prefix, table.funs, table_params(table, name, params), vals, Nrepeat,
+                              sorted_opts)
+                        .Mevals();
+            }
+        }
+        out << res;
+    }
+}
+
+// Latency of `name` for every table of one precision. Tables of unspecified width (eigen_dxx), or wider than the
+// chain buffers, have no lane count to call with and are listed as skipped.
+template <typename VAL_T>
+void run_latency_tables(BenchLog &out, const std::string &name,
+                        const std::vector<KernelTable<multi_eval_func<VAL_T>>> &tables,
+                        const std::unordered_map<std::string, Params> &params, const Eigen::VectorX<VAL_T> &vals,
+                        size_t n_calls, const RunOptions &opts) {
+    for (const auto &table : tables) {
+        const int width = EntrySpec(table.prefix).width;
+        if (width < 1 || width > max_latency_width) {
+            if (table.funs.count(name) && opts.enabled(table.prefix))
+                out << table.prefix + "_" + name + ": " << "skipped, no lane count of 1 to " << max_latency_width
+                    << "\n";
+            continue;
+        }
+        out << test_latency(name, table.prefix, table.funs, table_params(table, name, params), vals, n_calls, width,
+                            opts);
+    }
+}
+
+// --list: every table with the ISA tier it needs and its functions
+void print_registry(std::ostream &os, const KernelRegistry &registry) {
+    registry.for_each_table([&os](const auto &table) {
+        std::set<std::string> names;
+        for (const auto &kv : table.funs)
+            names.insert(kv.first);
+        os << std::left << std::setw(20) << table.prefix << std::setw(8) << (table.isa ? isa_name(*table.isa) : "base");
+        for (const auto &name : names)
+            os << " " << name;
+        os << "\n";
+    });
+}
+
 std::set<std::string> parse_args(int argc, char *argv[]) {
     std::set<std::string> res;
     for (int i = 0; i < argc; ++i)
-        res.insert(argv[i]);
+        if (std::string(argv[i]).rfind("--", 0) != 0)
+            res.insert(argv[i]);
 
     return res;
 }
 
-inline cdouble gsl_complex_wrapper(cdouble z, int (*f)(double, double, gsl_sf_result *, gsl_sf_result *)) {
-    gsl_sf_result re, im;
-    f(z.real(), z.imag(), &re, &im);
-    return cdouble{re.val, im.val};
+// Options of the form --flag or --flag=value. Flags without a value map to an empty string.
+std::unordered_map<std::string, std::string> parse_flags(int argc, char *argv[]) {
+    std::unordered_map<std::string, std::string> res;
+    for (int i = 0; i < argc; ++i) {
+        const std::string arg(argv[i]);
+        if (arg.rfind("--", 0) != 0)
+            continue;
+        const std::size_t eq = arg.find('=');
+        if (eq == std::string::npos)
+            res[arg.substr(2)] = "";
+        else
+            res[arg.substr(2, eq - 2)] = arg.substr(eq + 1);
+    }
+
+    return res;
 }
 
-std::string exec(const char *cmd) {
-    // https://stackoverflow.com/a/478960
-    std::array<char, 128> buffer;
-    std::string result;
-    std::unique_ptr<FILE, decltype(&pclose)> pipe(popen(cmd, "r"), pclose);
-    if (!pipe) {
-        throw std::runtime_error("popen() failed!");
-    }
-    while (fgets(buffer.data(), buffer.size(), pipe.get()) != nullptr) {
-        result += buffer.data();
-    }
-    result.pop_back();
-    return result;
+// Benchmark selection read from a TOML file, see config/example.toml. Anything left out keeps its default.
+class BenchConfig {
+  public:
+    std::set<std::string> functions;
+    std::set<std::string> libraries;
+    std::set<std::string> precisions;
+    std::set<int> vector_widths;
+    std::vector<int> threads;
+    int warmup = 0;
+    int samples = 1;
+    std::string baobzi_cache;
+    double remez_tol = 0.0; // 0: no remez entries
+    std::vector<std::pair<int, int>> run_sets;
+    std::unordered_map<std::string, std::pair<double, double>> domains;
+    std::unordered_map<std::string, std::pair<double, double>> domains2;
+    std::string inputs;
+    std::string order;
+    std::unordered_map<std::string, std::vector<double>> cutoffs;
+    std::string arena;
+    std::string pin;
+};
+
+BenchConfig load_config(const std::string &fname) {
+    BenchConfig config;
+    const toml::value data = toml::parse(fname);
+    const toml::table &table = data.as_table();
+
+    for (auto &fun : toml::find_or<std::vector<std::string>>(data, "functions", {}))
+        config.functions.insert(fun);
+    for (auto &lib : toml::find_or<std::vector<std::string>>(data, "libraries", {}))
+        config.libraries.insert(lib);
+    for (auto &prec : toml::find_or<std::vector<std::string>>(data, "precisions", {}))
+        config.precisions.insert(prec);
+    for (auto width : toml::find_or<std::vector<int>>(data, "vector_widths", {}))
+        config.vector_widths.insert(width);
+    config.threads = toml::find_or<std::vector<int>>(data, "threads", {});
+    config.warmup = toml::find_or<int>(data, "warmup", 0);
+    config.samples = toml::find_or<int>(data, "samples", 1);
+    config.baobzi_cache = toml::find_or<std::string>(data, "baobzi_cache", "");
+    config.remez_tol = toml::find_or<double>(data, "remez_tol", 0.0);
+    config.inputs = toml::find_or<std::string>(data, "inputs", "");
+    config.order = toml::find_or<std::string>(data, "order", "");
+    config.arena = toml::find_or<std::string>(data, "arena", "");
+    config.pin = toml::find_or<std::string>(data, "pin", "");
+
+    if (table.count("run_sets"))
+        for (const auto &run_set : toml::find(data, "run_sets").as_array())
+            config.run_sets.push_back({toml::find<int>(run_set, "n_eval"), toml::find<int>(run_set, "n_repeat")});
+
+    for (auto [key, domains] : {std::pair{"domains", &config.domains}, std::pair{"domains2", &config.domains2}})
+        if (table.count(key))
+            for (const auto &[name, domain] : toml::find(data, key).as_table()) {
+                const auto bounds = toml::get<std::vector<double>>(domain);
+                if (bounds.size() != 2)
+                    throw std::runtime_error("Domain of '" + name + "' in " + fname + " needs exactly two bounds");
+                (*domains)[name] = {bounds[0], bounds[1]};
+            }
+
+    if (table.count("cutoffs"))
+        for (const auto &[name, cutoffs] : toml::find(data, "cutoffs").as_table())
+            config.cutoffs[name] = toml::get<std::vector<double>>(cutoffs);
+
+    return config;
 }
 
+// ALM_VERSION_STRING of the loaded libalm.so. It is a local symbol, so dlsym can't see it: it's looked up in the
+// .symtab of the mapped file and read at its address in the process.
 std::string get_alm_version() {
-    std::string offset_str = "0x" + exec("objdump -t ../extern/amd-libm/lib/libalm.so --section=.rodata | grep -m1 "
-                                         "ALM_VERSION_STRING | cut -d' ' -f 1");
-    size_t offset = strtol(offset_str.c_str(), NULL, 0);
-    FILE *obj = fopen("../extern/amd-libm/lib/libalm.so", "r");
-    fseek(obj, offset, 0);
-    char buf[16];
-    fread(buf, sizeof(char), 16, obj);
-    fclose(obj);
-    return buf;
+    link_map *map = nullptr;
+    if (!alm_handle() || dlinfo(alm_handle(), RTLD_DI_LINKMAP, &map) || !map)
+        throw std::runtime_error("libalm.so not loaded");
+    std::ifstream f(map->l_name, std::ios::binary);
+    const auto read = [&f](std::size_t offset, void *dst, std::size_t size) {
+        if (!f.seekg(offset).read(static_cast<char *>(dst), size))
+            throw std::runtime_error("Truncated ELF file");
+    };
+
+    Elf64_Ehdr ehdr;
+    read(0, &ehdr, sizeof(ehdr));
+    if (std::memcmp(ehdr.e_ident, ELFMAG, SELFMAG) || ehdr.e_ident[EI_CLASS] != ELFCLASS64)
+        throw std::runtime_error(std::string(map->l_name) + " is not a 64-bit ELF file");
+    std::vector<Elf64_Shdr> sections(ehdr.e_shnum);
+    read(ehdr.e_shoff, sections.data(), sections.size() * sizeof(Elf64_Shdr));
+    for (const auto &symtab : sections) {
+        if (symtab.sh_type != SHT_SYMTAB || symtab.sh_link >= sections.size())
+            continue;
+        std::vector<Elf64_Sym> syms(symtab.sh_size / sizeof(Elf64_Sym));
+        read(symtab.sh_offset, syms.data(), syms.size() * sizeof(Elf64_Sym));
+        std::vector<char> names(sections[symtab.sh_link].sh_size + 1);
+        read(sections[symtab.sh_link].sh_offset, names.data(), names.size() - 1);
+        for (const auto &sym : syms)
+            if (sym.st_name < names.size() && !std::strcmp(&names[sym.st_name], "ALM_VERSION_STRING") &&
+                sym.st_shndx != SHN_UNDEF) {
+                const char *version = reinterpret_cast<const char *>(map->l_addr + sym.st_value);
+                return std::string(version, strnlen(version, sym.st_size ? sym.st_size : 64));
+            }
+    }
+    throw std::runtime_error(std::string(map->l_name) + " has no ALM_VERSION_STRING symbol (stripped?)");
 }
 
 std::string get_sleef_version() {
@@ -367,38 +1275,285 @@ std::string get_af_version() {
            std::to_string(VECTORCLASS_H % 10);
 }
 
-std::string get_sctl_version() { return exec("cd ../extern/SCTL; git describe --tags"); }
+std::string get_sctl_version() { return SF_SCTL_VERSION; }
 
-std::string get_baobzi_version() { return exec("cd ../extern/baobzi; git describe --tags").substr(1); }
+std::string get_baobzi_version() { return SF_BAOBZI_VERSION; }
 
 std::string get_eigen_version() {
     return std::to_string(EIGEN_WORLD_VERSION) + "." + std::to_string(EIGEN_MAJOR_VERSION) + "." +
            std::to_string(EIGEN_MINOR_VERSION);
 }
 
-std::string get_cpu_name() { return exec("grep -m1 'model name' /proc/cpuinfo | cut -d' ' --complement -f1-3"); }
+// The brand string of CPUID leaves 0x80000002 to 0x80000004, what /proc/cpuinfo shows as the model name
+std::string get_cpu_name() {
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned int regs[12];
+    if (__get_cpuid_max(0x80000000, nullptr) < 0x80000004)
+        throw std::runtime_error("CPUID has no brand string");
+    for (unsigned int leaf = 0; leaf < 3; ++leaf)
+        __get_cpuid(0x80000002 + leaf, &regs[4 * leaf], &regs[4 * leaf + 1], &regs[4 * leaf + 2], &regs[4 * leaf + 3]);
+    std::string name(reinterpret_cast<const char *>(regs), strnlen(reinterpret_cast<const char *>(regs), 48));
+    name.erase(0, name.find_first_not_of(' '));
+    name.erase(name.find_last_not_of(' ') + 1);
+    return name;
+#else
+    throw std::runtime_error("No CPUID");
+#endif
+}
+
+// Version probes that fail (no libalm.so, no CPUID) report "unknown"
+std::string probe_version(std::string (*get_version)()) {
+    try {
+        return get_version();
+    } catch (const std::exception &) {
+        return "unknown";
+    }
+}
+
+// Run metadata for the structured output headers. amdlibm is "unknown" for a stripped libalm.so as well, since its
+// version is a local symbol that only the .symtab has.
+BenchLog::Metadata get_metadata() {
+    char hostname[256] = "unknown";
+    gethostname(hostname, sizeof(hostname) - 1);
+    char date[64];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+
+    return {
+        {"date", date},
+        {"hostname", hostname},
+        {"cpu", probe_version(get_cpu_name)},
+        {"glibc", gnu_get_libc_version()},
+        {"compiler", __VERSION__},
+        {"cxx_flags", SF_CXX_FLAGS},
+        {"eigen_packets", eigen_packets()},
+        {"agnerfog", get_af_version()},
+        {"amdlibm", probe_version(get_alm_version)},
+        {"baobzi", probe_version(get_baobzi_version)},
+        {"boost", BOOST_LIB_VERSION},
+        {"eigen", get_eigen_version()},
+        {"gsl", GSL_VERSION},
+        {"sctl", probe_version(get_sctl_version)},
+        {"sleef", get_sleef_version()},
+    };
+}
 
 double baobzi_fun_wrapper(const double *x, const void *data) {
     auto *myfun = (std::function<double(double)> *)data;
     return (*myfun)(*x);
 }
 
-std::shared_ptr<baobzi::Baobzi> create_baobzi_func(void *infun, const std::pair<double, double> &domain) {
+// Cache file of a fitted approximant. Everything that changes the fit is part of the name, so stale files are never
+// picked up, only left behind.
+std::string baobzi_cache_file(const std::string &dir, const std::string &key, const std::pair<double, double> &domain,
+                              int order, double tol, const std::string &baobzi_version) {
+    std::ostringstream ss;
+    ss.precision(17);
+    ss << key << "_" << domain.first << "_" << domain.second << "_o" << order << "_t" << tol << "_v" << baobzi_version
+       << ".baobzi";
+    return (std::filesystem::path(dir) / ss.str()).string();
+}
+
+// Fit infun on domain, or restore the fit from cache_file if it exists. New fits are saved to cache_file through a
+// temporary file, so concurrent runs sharing a cache never see partial files. An empty cache_file disables caching.
+std::shared_ptr<baobzi::Baobzi> create_baobzi_func(void *infun, const std::pair<double, double> &domain,
+                                                   const std::string &cache_file = "", int order = 8,
+                                                   double tol = 1E-10) {
+    if (!cache_file.empty() && std::filesystem::exists(cache_file))
+        return std::shared_ptr<baobzi::Baobzi>(new baobzi::Baobzi(cache_file.c_str()));
+
     baobzi_input_t input = {.func = baobzi_fun_wrapper,
                             .data = infun,
                             .dim = 1,
-                            .order = 8,
-                            .tol = 1E-10,
+                            .order = order,
+                            .tol = tol,
                             .minimum_leaf_fraction = 0.6,
                             .split_multi_eval = 0};
     double hl = 0.5 * (domain.second - domain.first);
     double center = domain.first + hl;
 
-    return std::shared_ptr<baobzi::Baobzi>(new baobzi::Baobzi(&input, &center, &hl));
+    auto func = std::shared_ptr<baobzi::Baobzi>(new baobzi::Baobzi(&input, &center, &hl));
+    if (!cache_file.empty()) {
+        std::filesystem::create_directories(std::filesystem::path(cache_file).parent_path());
+        const std::string tmp_file = cache_file + ".tmp" + std::to_string(getpid());
+        func->save(tmp_file.c_str());
+        std::filesystem::rename(tmp_file, cache_file);
+    }
+    return func;
+}
+
+// Batch entry of a fit, sharing ownership of it
+multi_eval_func<double> baobzi_eval(std::shared_ptr<baobzi::Baobzi> func) {
+    return [func](const double *x, double *res, size_t N) { (*func)(x, res, N); };
+}
+
+// One point of the Baobzi order/tolerance sweep
+class BaobziFit {
+  public:
+    int order;
+    double tol;
+    double fit_time;
+    std::uintmax_t bytes; // size of the saved tree, a close proxy for its memory footprint
+    double Mevals;
+    double max_abs;
+    double max_rel;
+    bool pareto = false; // no other fit is both at least as fast and at least as accurate
+};
+
+void mark_pareto(std::vector<BaobziFit> &fits) {
+    for (auto &fit : fits) {
+        fit.pareto = true;
+        for (auto &other : fits) {
+            const bool no_worse = other.Mevals >= fit.Mevals && other.max_abs <= fit.max_abs;
+            const bool better = other.Mevals > fit.Mevals || other.max_abs < fit.max_abs;
+            if (no_worse && better) {
+                fit.pareto = false;
+                break;
+            }
+        }
+    }
+}
+
+// Fit `name` for every order and tolerance, then time and check each fit like a regular baobzi_dx1 entry. The
+// originals are timed on the same inputs for reference.
+void baobzi_sweep(std::ostream &os, const std::string &name, std::function<double(double)> &fun,
+                  std::unordered_map<std::string, Params> &params, const Eigen::VectorXd &vals,
+                  const std::vector<const KernelTable<multi_eval_func<double>> *> &originals,
+                  const RunOptions &opts) {
+    const std::vector<int> orders = {6, 8, 10, 12, 14, 16};
+    const std::vector<double> tols = {1E-6, 1E-8, 1E-10, 1E-12, 1E-14};
+    const auto &domain = params[name].domain;
+    const std::string tmp_file =
+        (std::filesystem::temp_directory_path() / ("sf_baobzi_" + std::to_string(getpid()) + ".baobzi")).string();
+
+    std::vector<BaobziFit> fits;
+    for (int order : orders) {
+        for (double tol : tols) {
+            const struct timespec st = get_wtime();
+            auto func = create_baobzi_func((void *)(&fun), domain, "", order, tol);
+            const struct timespec ft = get_wtime();
+
+            func->save(tmp_file.c_str());
+            const std::uintmax_t bytes = std::filesystem::file_size(tmp_file);
+            std::filesystem::remove(tmp_file);
+
+            std::unordered_map<std::string, multi_eval_func<double>> funs = {{name, baobzi_eval(func)}};
+            const auto res = test_func(name, "baobzi_dx1", funs, params, vals, 1, opts);
+            const double nan = std::numeric_limits<double>::quiet_NaN();
+            fits.push_back({order, tol, get_wtime_diff(&st, &ft), bytes, res.Mevals(),
+                            res.errors ? res.errors->max_abs : nan, res.errors ? res.errors->max_rel : nan});
+        }
+    }
+    mark_pareto(fits);
+
+    using std::left;
+    using std::setw;
+    os << "baobzi sweep: " << name << " on [" << domain.first << ", " << domain.second << "]\n";
+    for (auto *table : originals) {
+        const auto res = test_func(name, table->prefix, table->funs, params, vals, 1, opts);
+        if (res.n_res)
+            os << "    " << left << setw(10) << table->prefix << "Mevals/s: " << res.Mevals() << "\n";
+    }
+    os << "    " << left << setw(7) << "order" << setw(8) << "tol" << setw(12) << "fit_time" << setw(12) << "bytes"
+       << setw(12) << "Mevals/s" << setw(12) << "max_abs" << setw(12) << "max_rel"
+       << "pareto\n";
+    for (auto &fit : fits) {
+        os.precision(3);
+        os << "    " << left << setw(7) << fit.order << setw(8) << fit.tol << setw(12) << fit.fit_time << setw(12)
+           << fit.bytes << setw(12) << fit.Mevals << setw(12) << fit.max_abs << setw(12) << fit.max_rel
+           << (fit.pareto ? "*" : "") << "\n";
+    }
+    os << "\n";
 }
 
 int main(int argc, char *argv[]) {
     std::set<std::string> input_keys = parse_args(argc - 1, argv + 1);
+    std::unordered_map<std::string, std::string> flags = parse_flags(argc - 1, argv + 1);
+
+    // --compare=OLD.csv,NEW.csv: the change of every entry the two --csv runs share, then exit with status 1 if one
+    // got slower by more than --threshold percent (default 5) beyond the noise of its samples, or its max ULP error
+    // grew by more than --ulp-threshold (default 1)
+    if (flags.count("compare")) {
+        const std::size_t comma = flags["compare"].find(',');
+        if (comma == std::string::npos)
+            throw std::runtime_error("--compare needs two result files, --compare=OLD.csv,NEW.csv");
+        const ResultFile old_file(flags["compare"].substr(0, comma)), new_file(flags["compare"].substr(comma + 1));
+        const double threshold = flags.count("threshold") ? std::stod(flags["threshold"]) / 100 : 0.05;
+        const double ulp_threshold = flags.count("ulp-threshold") ? std::stod(flags["ulp-threshold"]) : 1.0;
+        return compare_results(std::cout, old_file, new_file, threshold, ulp_threshold) ? 1 : 0;
+    }
+
+    // --config=file.toml: select libraries, widths, functions, domains, run sets and thread counts
+    BenchConfig config;
+    if (flags.count("config"))
+        config = load_config(flags["config"]);
+    input_keys.insert(config.functions.begin(), config.functions.end());
+
+    // --threads[=max]: repeat every entry on 1, 2, 4, ... pinned worker threads to get per-core scaling curves
+    std::vector<int> thread_counts = {0};
+    if (!config.threads.empty())
+        thread_counts = config.threads;
+    if (flags.count("threads")) {
+        const int max_threads =
+            flags["threads"].empty() ? int(allowed_cpus().size()) : std::stoi(flags["threads"]);
+        thread_counts = get_thread_counts(max_threads);
+    }
+
+    // --latency[=n_calls]: after the throughput runs, time dependent chains of single calls
+    const std::size_t n_latency_calls =
+        flags.count("latency") ? (flags["latency"].empty() ? 1000000 : std::stoul(flags["latency"])) : 0;
+
+    RunOptions base_opts;
+    base_opts.libraries = config.libraries;
+    base_opts.precisions = config.precisions;
+    base_opts.vector_widths = config.vector_widths;
+
+    // --pin=compact|scatter: fill one NUMA node with workers before the next, or alternate between nodes. Each worker
+    // places its slice of the buffers on its own node.
+    const Topology topology;
+    const std::string pin = flags.count("pin") ? flags["pin"] : config.pin.empty() ? "compact" : config.pin;
+    base_opts.cpus = topology.worker_cpus(pin);
+    base_opts.topology = &topology;
+
+    // --accuracy[=n_samples]: report max/RMS ULP and relative error against a 50 digit reference
+    if (flags.count("accuracy"))
+        base_opts.n_accuracy = flags["accuracy"].empty() ? 1024 : std::stoul(flags["accuracy"]);
+
+    // --warmup[=n] --samples=k --cycles: untimed passes, then report the median of k timed passes
+    base_opts.n_warmup = config.warmup;
+    base_opts.n_samples = config.samples;
+    if (flags.count("warmup"))
+        base_opts.n_warmup = flags["warmup"].empty() ? 1 : std::stoi(flags["warmup"]);
+    if (flags.count("samples"))
+        base_opts.n_samples = std::max(1, std::stoi(flags["samples"]));
+    base_opts.cycles = flags.count("cycles");
+
+    // --perf[=event,...]: hardware counters per entry, e.g. --perf=cycles,instructions,r40c7
+    std::unique_ptr<PerfCounters> perf;
+    if (flags.count("perf")) {
+        std::vector<std::string> events = PerfCounters::default_events();
+        if (!flags["perf"].empty()) {
+            events.clear();
+            std::istringstream ss(flags["perf"]);
+            for (std::string event; std::getline(ss, event, ',');)
+                events.push_back(event);
+        }
+        perf = std::make_unique<PerfCounters>(events);
+        if (!perf->empty())
+            base_opts.perf = perf.get();
+    }
+
+    // --isa=sse4.2,avx2,avx512: vector kernel tiers to run, default every tier this CPU supports
+    std::vector<ISA> isas;
+    if (flags.count("isa") && !flags["isa"].empty()) {
+        std::istringstream ss(flags["isa"]);
+        for (std::string isa; std::getline(ss, isa, ',');)
+            isas.push_back(parse_isa(isa));
+    } else {
+        for (ISA isa : {ISA::SSE42, ISA::AVX2, ISA::AVX512})
+            if (isa_supported(isa))
+                isas.push_back(isa);
+    }
 
     std::unordered_map<std::string, Params> params = {
         {"sin_pi", {.domain{0.0, 2.0}}},     {"cos_pi", {.domain{0.0, 2.0}}},     {"sin", {.domain{0.0, 2 * M_PI}}},
@@ -407,774 +1562,71 @@ int main(int argc, char *argv[]) {
         {"erfc", {.domain{-1.0, 1.0}}},      {"exp", {.domain{-10.0, 10.0}}},     {"log", {.domain{0.0, 10.0}}},
         {"asinh", {.domain{-100.0, 100.0}}}, {"acosh", {.domain{1.0, 1000.0}}},   {"atanh", {.domain{-1.0, 1.0}}},
         {"bessel_Y0", {.domain{0.1, 30.0}}}, {"bessel_Y1", {.domain{0.1, 30.0}}}, {"bessel_Y2", {.domain{0.1, 30.0}}},
+        // Two-argument functions, see multi_eval_func2. Bessel orders 0 to 9.
+        {"pow", {.domain{0.1, 10.0}, .domain2{-5.0, 5.0}}},
+        {"atan2", {.domain{-10.0, 10.0}, .domain2{-10.0, 10.0}}},
+        {"hypot", {.domain{-100.0, 100.0}, .domain2{-100.0, 100.0}}},
+        {"fmod", {.domain{-100.0, 100.0}, .domain2{0.1, 10.0}}},
+        {"bessel_Jn", {.domain{0.0, 30.0}, .domain2{0.0, 10.0}}},
+        {"bessel_Kn", {.domain{0.1, 30.0}, .domain2{0.0, 10.0}}},
     };
-
-    void *handle = dlopen("libalm.so", RTLD_NOW);
-
-    using C_FUN1F = float (*)(float);
-    using C_FUN2F = float (*)(float, float);
-    C_FUN1F amd_sinf = (C_FUN1F)dlsym(handle, "amd_sinf");
-    C_FUN1F amd_cosf = (C_FUN1F)dlsym(handle, "amd_cosf");
-    C_FUN1F amd_tanf = (C_FUN1F)dlsym(handle, "amd_tanf");
-    C_FUN1F amd_sinhf = (C_FUN1F)dlsym(handle, "amd_sinhf");
-    C_FUN1F amd_coshf = (C_FUN1F)dlsym(handle, "amd_coshf");
-    C_FUN1F amd_tanhf = (C_FUN1F)dlsym(handle, "amd_tanhf");
-    C_FUN1F amd_asinf = (C_FUN1F)dlsym(handle, "amd_asinf");
-    C_FUN1F amd_acosf = (C_FUN1F)dlsym(handle, "amd_acosf");
-    C_FUN1F amd_atanf = (C_FUN1F)dlsym(handle, "amd_atanf");
-    C_FUN1F amd_asinhf = (C_FUN1F)dlsym(handle, "amd_asinhf");
-    C_FUN1F amd_acoshf = (C_FUN1F)dlsym(handle, "amd_acoshf");
-    C_FUN1F amd_atanhf = (C_FUN1F)dlsym(handle, "amd_atanhf");
-    C_FUN1F amd_logf = (C_FUN1F)dlsym(handle, "amd_logf");
-    C_FUN1F amd_log2f = (C_FUN1F)dlsym(handle, "amd_log2f");
-    C_FUN1F amd_log10f = (C_FUN1F)dlsym(handle, "amd_log10f");
-    C_FUN1F amd_expf = (C_FUN1F)dlsym(handle, "amd_expf");
-    C_FUN1F amd_exp2f = (C_FUN1F)dlsym(handle, "amd_exp2f");
-    C_FUN1F amd_exp10f = (C_FUN1F)dlsym(handle, "amd_exp10f");
-    C_FUN1F amd_sqrtf = (C_FUN1F)dlsym(handle, "amd_sqrtf");
-    C_FUN2F amd_powf = (C_FUN2F)dlsym(handle, "amd_powf");
-
-    using C_FUN1D = double (*)(double);
-    using C_FUN2D = double (*)(double, double);
-    C_FUN1D amd_sin = (C_FUN1D)dlsym(handle, "amd_sin");
-    C_FUN1D amd_cos = (C_FUN1D)dlsym(handle, "amd_cos");
-    C_FUN1D amd_tan = (C_FUN1D)dlsym(handle, "amd_tan");
-    C_FUN1D amd_sinh = (C_FUN1D)dlsym(handle, "amd_sinh");
-    C_FUN1D amd_cosh = (C_FUN1D)dlsym(handle, "amd_cosh");
-    C_FUN1D amd_tanh = (C_FUN1D)dlsym(handle, "amd_tanh");
-    C_FUN1D amd_asin = (C_FUN1D)dlsym(handle, "amd_asin");
-    C_FUN1D amd_acos = (C_FUN1D)dlsym(handle, "amd_acos");
-    C_FUN1D amd_atan = (C_FUN1D)dlsym(handle, "amd_atan");
-    C_FUN1D amd_asinh = (C_FUN1D)dlsym(handle, "amd_asinh");
-    C_FUN1D amd_acosh = (C_FUN1D)dlsym(handle, "amd_acosh");
-    C_FUN1D amd_atanh = (C_FUN1D)dlsym(handle, "amd_atanh");
-    C_FUN1D amd_log = (C_FUN1D)dlsym(handle, "amd_log");
-    C_FUN1D amd_log2 = (C_FUN1D)dlsym(handle, "amd_log2");
-    C_FUN1D amd_log10 = (C_FUN1D)dlsym(handle, "amd_log10");
-    C_FUN1D amd_exp = (C_FUN1D)dlsym(handle, "amd_exp");
-    C_FUN1D amd_exp2 = (C_FUN1D)dlsym(handle, "amd_exp2");
-    C_FUN1D amd_exp10 = (C_FUN1D)dlsym(handle, "amd_exp10");
-    C_FUN1D amd_sqrt = (C_FUN1D)dlsym(handle, "amd_sqrt");
-    C_FUN2D amd_pow = (C_FUN2D)dlsym(handle, "amd_pow");
-
-    using C_FX8_FUN1F = Vec8f (*)(Vec8f);
-    using C_FX8_FUN2F = Vec8f (*)(Vec8f, Vec8f);
-    C_FX8_FUN1F amd_vrs8_sinf = (C_FX8_FUN1F)dlsym(handle, "amd_vrs8_sinf");
-    C_FX8_FUN1F amd_vrs8_cosf = (C_FX8_FUN1F)dlsym(handle, "amd_vrs8_cosf");
-    C_FX8_FUN1F amd_vrs8_tanf = (C_FX8_FUN1F)dlsym(handle, "amd_vrs8_tanf");
-    C_FX8_FUN1F amd_vrs8_logf = (C_FX8_FUN1F)dlsym(handle, "amd_vrs8_logf");
-    C_FX8_FUN1F amd_vrs8_log2f = (C_FX8_FUN1F)dlsym(handle, "amd_vrs8_log2f");
-    C_FX8_FUN1F amd_vrs8_expf = (C_FX8_FUN1F)dlsym(handle, "amd_vrs8_expf");
-    C_FX8_FUN1F amd_vrs8_exp2f = (C_FX8_FUN1F)dlsym(handle, "amd_vrs8_exp2f");
-    C_FX8_FUN2F amd_vrs8_powf = (C_FX8_FUN2F)dlsym(handle, "amd_vrs8_powf");
-
-    using C_DX4_FUN1D = Vec4d (*)(Vec4d);
-    using C_DX4_FUN2D = Vec4d (*)(Vec4d, Vec4d);
-    C_DX4_FUN1D amd_vrd4_sin = (C_DX4_FUN1D)dlsym(handle, "amd_vrd4_sin");
-    C_DX4_FUN1D amd_vrd4_cos = (C_DX4_FUN1D)dlsym(handle, "amd_vrd4_cos");
-    C_DX4_FUN1D amd_vrd4_tan = (C_DX4_FUN1D)dlsym(handle, "amd_vrd4_tan");
-    C_DX4_FUN1D amd_vrd4_log = (C_DX4_FUN1D)dlsym(handle, "amd_vrd4_log");
-    C_DX4_FUN1D amd_vrd4_log2 = (C_DX4_FUN1D)dlsym(handle, "amd_vrd4_log2");
-    C_DX4_FUN1D amd_vrd4_exp = (C_DX4_FUN1D)dlsym(handle, "amd_vrd4_exp");
-    C_DX4_FUN1D amd_vrd4_exp2 = (C_DX4_FUN1D)dlsym(handle, "amd_vrd4_exp2");
-    C_DX4_FUN2D amd_vrd4_pow = (C_DX4_FUN2D)dlsym(handle, "amd_vrd4_pow");
-
-    std::unordered_map<std::string, multi_eval_func<double>> fort_funs = {
-        {"bessel_Y0", scalar_func_apply<double>([](double x) -> double {
-             int n = 0;
-             double y;
-             fort_bessel_yn_(&n, &x, &y);
-             return y;
-         })},
-        {"bessel_J0", scalar_func_apply<double>([](double x) -> double {
-             int n = 0;
-             double y;
-             fort_bessel_jn_(&n, &x, &y);
-             return y;
-         })},
-    };
-
-    std::unordered_map<std::string, fun_cdx1_x2> hank10x_funs = {
-        {"hank103", [](cdouble z) -> std::pair<cdouble, cdouble> {
-             cdouble h0, h1;
-             int ifexpon = 1;
-             hank103_((double _Complex *)&z, (double _Complex *)&h0, (double _Complex *)&h1, &ifexpon);
-             return {h0, h1};
-         }}};
-
-    std::unordered_map<std::string, multi_eval_func<double>> gsl_funs = {
-        {"sin_pi", scalar_func_apply<double>([](double x) -> double { return gsl_sf_sin_pi(x); })},
-        {"cos_pi", scalar_func_apply<double>([](double x) -> double { return gsl_sf_cos_pi(x); })},
-        {"sin", scalar_func_apply<double>([](double x) -> double { return gsl_sf_sin(x); })},
-        {"cos", scalar_func_apply<double>([](double x) -> double { return gsl_sf_cos(x); })},
-        {"sinc", scalar_func_apply<double>([](double x) -> double { return gsl_sf_sinc(x / M_PI); })},
-        {"sinc_pi", scalar_func_apply<double>([](double x) -> double { return gsl_sf_sinc(x); })},
-        {"erf", scalar_func_apply<double>([](double x) -> double { return gsl_sf_erf(x); })},
-        {"erfc", scalar_func_apply<double>([](double x) -> double { return gsl_sf_erfc(x); })},
-        {"tgamma", scalar_func_apply<double>([](double x) -> double { return gsl_sf_gamma(x); })},
-        {"lgamma", scalar_func_apply<double>([](double x) -> double { return gsl_sf_lngamma(x); })},
-        {"log", scalar_func_apply<double>([](double x) -> double { return gsl_sf_log(x); })},
-        {"exp", scalar_func_apply<double>([](double x) -> double { return gsl_sf_exp(x); })},
-        {"pow13", scalar_func_apply<double>([](double x) -> double { return gsl_sf_pow_int(x, 13); })},
-        {"bessel_Y0", scalar_func_apply<double>([](double x) -> double { return gsl_sf_bessel_Y0(x); })},
-        {"bessel_Y1", scalar_func_apply<double>([](double x) -> double { return gsl_sf_bessel_Y1(x); })},
-        {"bessel_Y2", scalar_func_apply<double>([](double x) -> double { return gsl_sf_bessel_Yn(2, x); })},
-        {"bessel_I0", scalar_func_apply<double>([](double x) -> double { return gsl_sf_bessel_I0(x); })},
-        {"bessel_I1", scalar_func_apply<double>([](double x) -> double { return gsl_sf_bessel_I1(x); })},
-        {"bessel_I2", scalar_func_apply<double>([](double x) -> double { return gsl_sf_bessel_In(2, x); })},
-        {"bessel_J0", scalar_func_apply<double>([](double x) -> double { return gsl_sf_bessel_J0(x); })},
-        {"bessel_J1", scalar_func_apply<double>([](double x) -> double { return gsl_sf_bessel_J1(x); })},
-        {"bessel_J2", scalar_func_apply<double>([](double x) -> double { return gsl_sf_bessel_Jn(2, x); })},
-        {"bessel_K0", scalar_func_apply<double>([](double x) -> double { return gsl_sf_bessel_K0(x); })},
-        {"bessel_K1", scalar_func_apply<double>([](double x) -> double { return gsl_sf_bessel_K1(x); })},
-        {"bessel_K2", scalar_func_apply<double>([](double x) -> double { return gsl_sf_bessel_Kn(2, x); })},
-        {"bessel_j0", scalar_func_apply<double>([](double x) -> double { return gsl_sf_bessel_j0(x); })},
-        {"bessel_j1", scalar_func_apply<double>([](double x) -> double { return gsl_sf_bessel_j1(x); })},
-        {"bessel_j2", scalar_func_apply<double>([](double x) -> double { return gsl_sf_bessel_j2(x); })},
-        {"bessel_y0", scalar_func_apply<double>([](double x) -> double { return gsl_sf_bessel_y0(x); })},
-        {"bessel_y1", scalar_func_apply<double>([](double x) -> double { return gsl_sf_bessel_y1(x); })},
-        {"bessel_y2", scalar_func_apply<double>([](double x) -> double { return gsl_sf_bessel_y2(x); })},
-        {"hermite_0", scalar_func_apply<double>([](double x) -> double { return gsl_sf_hermite(0, x); })},
-        {"hermite_1", scalar_func_apply<double>([](double x) -> double { return gsl_sf_hermite(1, x); })},
-        {"hermite_2", scalar_func_apply<double>([](double x) -> double { return gsl_sf_hermite(2, x); })},
-        {"hermite_3", scalar_func_apply<double>([](double x) -> double { return gsl_sf_hermite(3, x); })},
-        {"riemann_zeta", scalar_func_apply<double>([](double x) -> double { return gsl_sf_zeta(x); })},
-    };
-
-    // FIXME: check accuracy of this and this+test_func
-    std::unordered_map<std::string, multi_eval_func<cdouble>> gsl_complex_funs = {
-        {"sin",
-         scalar_func_apply<cdouble>([](cdouble z) -> cdouble { return gsl_complex_wrapper(z, gsl_sf_complex_sin_e); })},
-        {"cos",
-         scalar_func_apply<cdouble>([](cdouble z) -> cdouble { return gsl_complex_wrapper(z, gsl_sf_complex_cos_e); })},
-        {"log",
-         scalar_func_apply<cdouble>([](cdouble z) -> cdouble { return gsl_complex_wrapper(z, gsl_sf_complex_log_e); })},
-        {"dilog", scalar_func_apply<cdouble>(
-                      [](cdouble z) -> cdouble { return gsl_complex_wrapper(z, gsl_sf_complex_dilog_e); })},
-        {"lgamma", scalar_func_apply<cdouble>(
-                       [](cdouble z) -> cdouble { return gsl_complex_wrapper(z, gsl_sf_lngamma_complex_e); })},
-    };
-
-    std::unordered_map<std::string, multi_eval_func<float>> boost_funs_fx1 = {
-        {"sin_pi", scalar_func_apply<float>([](float x) -> float { return boost::math::sin_pi(x); })},
-        {"cos_pi", scalar_func_apply<float>([](float x) -> float { return boost::math::cos_pi(x); })},
-        {"tgamma", scalar_func_apply<float>([](float x) -> float { return boost::math::tgamma<float>(x); })},
-        {"lgamma", scalar_func_apply<float>([](float x) -> float { return boost::math::lgamma<float>(x); })},
-        {"digamma", scalar_func_apply<float>([](float x) -> float { return boost::math::digamma<float>(x); })},
-        {"pow13", scalar_func_apply<float>([](float x) -> float { return boost::math::pow<13>(x); })},
-        {"erf", scalar_func_apply<float>([](float x) -> float { return boost::math::erf(x); })},
-        {"erfc", scalar_func_apply<float>([](float x) -> float { return boost::math::erfc(x); })},
-        {"sinc_pi", scalar_func_apply<float>([](float x) -> float { return boost::math::sinc_pi(x); })},
-        {"bessel_Y0", scalar_func_apply<float>([](float x) -> float { return boost::math::cyl_neumann(0, x); })},
-        {"bessel_Y1", scalar_func_apply<float>([](float x) -> float { return boost::math::cyl_neumann(1, x); })},
-        {"bessel_Y2", scalar_func_apply<float>([](float x) -> float { return boost::math::cyl_neumann(2, x); })},
-        {"bessel_I0", scalar_func_apply<float>([](float x) -> float { return boost::math::cyl_bessel_i(0, x); })},
-        {"bessel_I1", scalar_func_apply<float>([](float x) -> float { return boost::math::cyl_bessel_i(1, x); })},
-        {"bessel_I2", scalar_func_apply<float>([](float x) -> float { return boost::math::cyl_bessel_i(2, x); })},
-        {"bessel_J0", scalar_func_apply<float>([](float x) -> float { return boost::math::cyl_bessel_j(0, x); })},
-        {"bessel_J1", scalar_func_apply<float>([](float x) -> float { return boost::math::cyl_bessel_j(1, x); })},
-        {"bessel_J2", scalar_func_apply<float>([](float x) -> float { return boost::math::cyl_bessel_j(2, x); })},
-        {"bessel_K0", scalar_func_apply<float>([](float x) -> float { return boost::math::cyl_bessel_k(0, x); })},
-        {"bessel_K1", scalar_func_apply<float>([](float x) -> float { return boost::math::cyl_bessel_k(1, x); })},
-        {"bessel_K2", scalar_func_apply<float>([](float x) -> float { return boost::math::cyl_bessel_k(2, x); })},
-        {"bessel_j0", scalar_func_apply<float>([](float x) -> float { return boost::math::sph_bessel(0, x); })},
-        {"bessel_j1", scalar_func_apply<float>([](float x) -> float { return boost::math::sph_bessel(1, x); })},
-        {"bessel_j2", scalar_func_apply<float>([](float x) -> float { return boost::math::sph_bessel(2, x); })},
-        {"bessel_y0", scalar_func_apply<float>([](float x) -> float { return boost::math::sph_neumann(0, x); })},
-        {"bessel_y1", scalar_func_apply<float>([](float x) -> float { return boost::math::sph_neumann(1, x); })},
-        {"bessel_y2", scalar_func_apply<float>([](float x) -> float { return boost::math::sph_neumann(2, x); })},
-        {"hermite_0", scalar_func_apply<float>([](float x) -> float { return boost::math::hermite(0, x); })},
-        {"hermite_1", scalar_func_apply<float>([](float x) -> float { return boost::math::hermite(1, x); })},
-        {"hermite_2", scalar_func_apply<float>([](float x) -> float { return boost::math::hermite(2, x); })},
-        {"hermite_3", scalar_func_apply<float>([](float x) -> float { return boost::math::hermite(3, x); })},
-        {"riemann_zeta", scalar_func_apply<float>([](float x) -> float { return boost::math::zeta(x); })},
-    };
-
-    std::unordered_map<std::string, multi_eval_func<double>> boost_funs_dx1 = {
-        {"sin_pi", scalar_func_apply<double>([](double x) -> double { return boost::math::sin_pi(x); })},
-        {"cos_pi", scalar_func_apply<double>([](double x) -> double { return boost::math::cos_pi(x); })},
-        {"tgamma", scalar_func_apply<double>([](double x) -> double { return boost::math::tgamma<double>(x); })},
-        {"lgamma", scalar_func_apply<double>([](double x) -> double { return boost::math::lgamma<double>(x); })},
-        {"digamma", scalar_func_apply<double>([](double x) -> double { return boost::math::digamma<double>(x); })},
-        {"pow13", scalar_func_apply<double>([](double x) -> double { return boost::math::pow<13>(x); })},
-        {"erf", scalar_func_apply<double>([](double x) -> double { return boost::math::erf(x); })},
-        {"erfc", scalar_func_apply<double>([](double x) -> double { return boost::math::erfc(x); })},
-        {"sinc_pi", scalar_func_apply<double>([](double x) -> double { return boost::math::sinc_pi(x); })},
-        {"bessel_Y0", scalar_func_apply<double>([](double x) -> double { return boost::math::cyl_neumann(0, x); })},
-        {"bessel_Y1", scalar_func_apply<double>([](double x) -> double { return boost::math::cyl_neumann(1, x); })},
-        {"bessel_Y2", scalar_func_apply<double>([](double x) -> double { return boost::math::cyl_neumann(2, x); })},
-        {"bessel_I0", scalar_func_apply<double>([](double x) -> double { return boost::math::cyl_bessel_i(0, x); })},
-        {"bessel_I1", scalar_func_apply<double>([](double x) -> double { return boost::math::cyl_bessel_i(1, x); })},
-        {"bessel_I2", scalar_func_apply<double>([](double x) -> double { return boost::math::cyl_bessel_i(2, x); })},
-        {"bessel_J0", scalar_func_apply<double>([](double x) -> double { return boost::math::cyl_bessel_j(0, x); })},
-        {"bessel_J1", scalar_func_apply<double>([](double x) -> double { return boost::math::cyl_bessel_j(1, x); })},
-        {"bessel_J2", scalar_func_apply<double>([](double x) -> double { return boost::math::cyl_bessel_j(2, x); })},
-        {"bessel_K0", scalar_func_apply<double>([](double x) -> double { return boost::math::cyl_bessel_k(0, x); })},
-        {"bessel_K1", scalar_func_apply<double>([](double x) -> double { return boost::math::cyl_bessel_k(1, x); })},
-        {"bessel_K2", scalar_func_apply<double>([](double x) -> double { return boost::math::cyl_bessel_k(2, x); })},
-        {"bessel_j0", scalar_func_apply<double>([](double x) -> double { return boost::math::sph_bessel(0, x); })},
-        {"bessel_j1", scalar_func_apply<double>([](double x) -> double { return boost::math::sph_bessel(1, x); })},
-        {"bessel_j2", scalar_func_apply<double>([](double x) -> double { return boost::math::sph_bessel(2, x); })},
-        {"bessel_y0", scalar_func_apply<double>([](double x) -> double { return boost::math::sph_neumann(0, x); })},
-        {"bessel_y1", scalar_func_apply<double>([](double x) -> double { return boost::math::sph_neumann(1, x); })},
-        {"bessel_y2", scalar_func_apply<double>([](double x) -> double { return boost::math::sph_neumann(2, x); })},
-        {"hermite_0", scalar_func_apply<double>([](double x) -> double { return boost::math::hermite(0, x); })},
-        {"hermite_1", scalar_func_apply<double>([](double x) -> double { return boost::math::hermite(1, x); })},
-        {"hermite_2", scalar_func_apply<double>([](double x) -> double { return boost::math::hermite(2, x); })},
-        {"hermite_3", scalar_func_apply<double>([](double x) -> double { return boost::math::hermite(3, x); })},
-        {"riemann_zeta", scalar_func_apply<double>([](double x) -> double { return boost::math::zeta(x); })},
-    };
-
-    std::unordered_map<std::string, multi_eval_func<float>> std_funs_fx1 = {
-        {"tgamma", scalar_func_apply<float>([](float x) -> float { return std::tgamma(x); })},
-        {"lgamma", scalar_func_apply<float>([](float x) -> float { return std::lgamma(x); })},
-        {"sin", scalar_func_apply<float>([](float x) -> float { return std::sin(x); })},
-        {"cos", scalar_func_apply<float>([](float x) -> float { return std::cos(x); })},
-        {"tan", scalar_func_apply<float>([](float x) -> float { return std::tan(x); })},
-        {"asin", scalar_func_apply<float>([](float x) -> float { return std::asin(x); })},
-        {"acos", scalar_func_apply<float>([](float x) -> float { return std::acos(x); })},
-        {"atan", scalar_func_apply<float>([](float x) -> float { return std::atan(x); })},
-        {"asin", scalar_func_apply<float>([](float x) -> float { return std::asin(x); })},
-        {"acos", scalar_func_apply<float>([](float x) -> float { return std::acos(x); })},
-        {"atan", scalar_func_apply<float>([](float x) -> float { return std::atan(x); })},
-        {"sinh", scalar_func_apply<float>([](float x) -> float { return std::sinh(x); })},
-        {"cosh", scalar_func_apply<float>([](float x) -> float { return std::cosh(x); })},
-        {"tanh", scalar_func_apply<float>([](float x) -> float { return std::tanh(x); })},
-        {"asinh", scalar_func_apply<float>([](float x) -> float { return std::asinh(x); })},
-        {"acosh", scalar_func_apply<float>([](float x) -> float { return std::acosh(x); })},
-        {"atanh", scalar_func_apply<float>([](float x) -> float { return std::atanh(x); })},
-        {"sin_pi", scalar_func_apply<float>([](float x) -> float { return std::sin(M_PI * x); })},
-        {"cos_pi", scalar_func_apply<float>([](float x) -> float { return std::cos(M_PI * x); })},
-        {"erf", scalar_func_apply<float>([](float x) -> float { return std::erf(x); })},
-        {"erfc", scalar_func_apply<float>([](float x) -> float { return std::erfc(x); })},
-        {"log", scalar_func_apply<float>([](float x) -> float { return std::log(x); })},
-        {"log2", scalar_func_apply<float>([](float x) -> float { return std::log2(x); })},
-        {"log10", scalar_func_apply<float>([](float x) -> float { return std::log10(x); })},
-        {"exp", scalar_func_apply<float>([](float x) -> float { return std::exp(x); })},
-        {"exp2", scalar_func_apply<float>([](float x) -> float { return std::exp2(x); })},
-        {"exp10", scalar_func_apply<float>([](float x) -> float { return exp10(x); })},
-        {"sqrt", scalar_func_apply<float>([](float x) -> float { return std::sqrt(x); })},
-        {"rsqrt", scalar_func_apply<float>([](float x) -> float { return 1.0 / std::sqrt(x); })},
-        {"pow3.5", scalar_func_apply<float>([](float x) -> float { return std::pow(x, 3.5); })},
-        {"pow13", scalar_func_apply<float>([](float x) -> float { return std::pow(x, 13); })},
-    };
-
-    std::unordered_map<std::string, multi_eval_func<double>> std_funs_dx1 = {
-        {"tgamma", scalar_func_apply<double>([](double x) -> double { return std::tgamma(x); })},
-        {"lgamma", scalar_func_apply<double>([](double x) -> double { return std::lgamma(x); })},
-        {"sin", scalar_func_apply<double>([](double x) -> double { return std::sin(x); })},
-        {"cos", scalar_func_apply<double>([](double x) -> double { return std::cos(x); })},
-        {"tan", scalar_func_apply<double>([](double x) -> double { return std::tan(x); })},
-        {"asin", scalar_func_apply<double>([](double x) -> double { return std::asin(x); })},
-        {"acos", scalar_func_apply<double>([](double x) -> double { return std::acos(x); })},
-        {"atan", scalar_func_apply<double>([](double x) -> double { return std::atan(x); })},
-        {"asin", scalar_func_apply<double>([](double x) -> double { return std::asin(x); })},
-        {"acos", scalar_func_apply<double>([](double x) -> double { return std::acos(x); })},
-        {"atan", scalar_func_apply<double>([](double x) -> double { return std::atan(x); })},
-        {"sinh", scalar_func_apply<double>([](double x) -> double { return std::sinh(x); })},
-        {"cosh", scalar_func_apply<double>([](double x) -> double { return std::cosh(x); })},
-        {"tanh", scalar_func_apply<double>([](double x) -> double { return std::tanh(x); })},
-        {"asinh", scalar_func_apply<double>([](double x) -> double { return std::asinh(x); })},
-        {"acosh", scalar_func_apply<double>([](double x) -> double { return std::acosh(x); })},
-        {"atanh", scalar_func_apply<double>([](double x) -> double { return std::atanh(x); })},
-        {"sin_pi", scalar_func_apply<double>([](double x) -> double { return std::sin(M_PI * x); })},
-        {"cos_pi", scalar_func_apply<double>([](double x) -> double { return std::cos(M_PI * x); })},
-        {"erf", scalar_func_apply<double>([](double x) -> double { return std::erf(x); })},
-        {"erfc", scalar_func_apply<double>([](double x) -> double { return std::erfc(x); })},
-        {"log", scalar_func_apply<double>([](double x) -> double { return std::log(x); })},
-        {"log2", scalar_func_apply<double>([](double x) -> double { return std::log2(x); })},
-        {"log10", scalar_func_apply<double>([](double x) -> double { return std::log10(x); })},
-        {"exp", scalar_func_apply<double>([](double x) -> double { return std::exp(x); })},
-        {"exp2", scalar_func_apply<double>([](double x) -> double { return std::exp2(x); })},
-        {"exp10", scalar_func_apply<double>([](double x) -> double { return exp10(x); })},
-        {"sqrt", scalar_func_apply<double>([](double x) -> double { return std::sqrt(x); })},
-        {"rsqrt", scalar_func_apply<double>([](double x) -> double { return 1.0 / std::sqrt(x); })},
-        {"pow3.5", scalar_func_apply<double>([](double x) -> double { return std::pow(x, 3.5); })},
-        {"pow13", scalar_func_apply<double>([](double x) -> double { return std::pow(x, 13); })},
-    };
-
-    std::unordered_map<std::string, multi_eval_func<float>> amdlibm_funs_fx1 = {
-        {"sin", scalar_func_apply<float>([&amd_sinf](float x) -> float { return amd_sinf(x); })},
-        {"cos", scalar_func_apply<float>([&amd_cosf](float x) -> float { return amd_cosf(x); })},
-        {"tan", scalar_func_apply<float>([&amd_tanf](float x) -> float { return amd_tanf(x); })},
-        {"sinh", scalar_func_apply<float>([&amd_sinhf](float x) -> float { return amd_sinhf(x); })},
-        {"cosh", scalar_func_apply<float>([&amd_coshf](float x) -> float { return amd_coshf(x); })},
-        {"tanh", scalar_func_apply<float>([&amd_tanhf](float x) -> float { return amd_tanhf(x); })},
-        {"asin", scalar_func_apply<float>([&amd_asinf](float x) -> float { return amd_asinf(x); })},
-        {"acos", scalar_func_apply<float>([&amd_acosf](float x) -> float { return amd_acosf(x); })},
-        {"atan", scalar_func_apply<float>([&amd_atanf](float x) -> float { return amd_atanf(x); })},
-        {"asinh", scalar_func_apply<float>([&amd_asinhf](float x) -> float { return amd_asinhf(x); })},
-        {"acosh", scalar_func_apply<float>([&amd_acoshf](float x) -> float { return amd_acoshf(x); })},
-        {"atanh", scalar_func_apply<float>([&amd_atanhf](float x) -> float { return amd_atanhf(x); })},
-        {"log", scalar_func_apply<float>([&amd_logf](float x) -> float { return amd_logf(x); })},
-        {"log2", scalar_func_apply<float>([&amd_log2f](float x) -> float { return amd_log2f(x); })},
-        {"log10", scalar_func_apply<float>([&amd_log10f](float x) -> float { return amd_log10f(x); })},
-        {"exp", scalar_func_apply<float>([&amd_expf](float x) -> float { return amd_expf(x); })},
-        {"exp2", scalar_func_apply<float>([&amd_exp2f](float x) -> float { return amd_exp2f(x); })},
-        {"exp10", scalar_func_apply<float>([&amd_exp10f](float x) -> float { return amd_exp10f(x); })},
-        {"sqrt", scalar_func_apply<float>([&amd_sqrtf](float x) -> float { return amd_sqrtf(x); })},
-        {"pow3.5", scalar_func_apply<float>([&amd_powf](float x) -> float { return amd_powf(x, 3.5); })},
-        {"pow13", scalar_func_apply<float>([&amd_powf](float x) -> float { return amd_powf(x, 13); })},
-    };
-
-    std::unordered_map<std::string, multi_eval_func<double>> amdlibm_funs_dx1 = {
-        {"sin", scalar_func_apply<double>([&amd_sin](double x) -> double { return amd_sin(x); })},
-        {"cos", scalar_func_apply<double>([&amd_cos](double x) -> double { return amd_cos(x); })},
-        {"tan", scalar_func_apply<double>([&amd_tan](double x) -> double { return amd_tan(x); })},
-        {"sinh", scalar_func_apply<double>([&amd_sinh](double x) -> double { return amd_sinh(x); })},
-        {"cosh", scalar_func_apply<double>([&amd_cosh](double x) -> double { return amd_cosh(x); })},
-        {"tanh", scalar_func_apply<double>([&amd_tanh](double x) -> double { return amd_tanh(x); })},
-        {"asin", scalar_func_apply<double>([&amd_asin](double x) -> double { return amd_asin(x); })},
-        {"acos", scalar_func_apply<double>([&amd_acos](double x) -> double { return amd_acos(x); })},
-        {"atan", scalar_func_apply<double>([&amd_atan](double x) -> double { return amd_atan(x); })},
-        {"asinh", scalar_func_apply<double>([&amd_asinh](double x) -> double { return amd_asinh(x); })},
-        {"acosh", scalar_func_apply<double>([&amd_acosh](double x) -> double { return amd_acosh(x); })},
-        {"atanh", scalar_func_apply<double>([&amd_atanh](double x) -> double { return amd_atanh(x); })},
-        {"log", scalar_func_apply<double>([&amd_log](double x) -> double { return amd_log(x); })},
-        {"log2", scalar_func_apply<double>([&amd_log2](double x) -> double { return amd_log2(x); })},
-        {"log10", scalar_func_apply<double>([&amd_log10](double x) -> double { return amd_log10(x); })},
-        {"exp", scalar_func_apply<double>([&amd_exp](double x) -> double { return amd_exp(x); })},
-        {"exp2", scalar_func_apply<double>([&amd_exp2](double x) -> double { return amd_exp2(x); })},
-        {"exp10", scalar_func_apply<double>([&amd_exp10](double x) -> double { return amd_exp10(x); })},
-        {"sqrt", scalar_func_apply<double>([&amd_sqrt](double x) -> double { return amd_sqrt(x); })},
-        {"pow3.5", scalar_func_apply<double>([&amd_pow](double x) -> double { return amd_pow(x, 3.5); })},
-        {"pow13", scalar_func_apply<double>([&amd_pow](double x) -> double { return amd_pow(x, 13); })},
-    };
-
-    std::unordered_map<std::string, multi_eval_func<double>> amdlibm_funs_dx4 = {
-        {"sin", vec_func_apply<Vec4d, double>([&amd_vrd4_sin](Vec4d x) -> Vec4d { return amd_vrd4_sin(x); })},
-        {"cos", vec_func_apply<Vec4d, double>([&amd_vrd4_cos](Vec4d x) -> Vec4d { return amd_vrd4_cos(x); })},
-        {"tan", vec_func_apply<Vec4d, double>([&amd_vrd4_tan](Vec4d x) -> Vec4d { return amd_vrd4_tan(x); })},
-        {"log", vec_func_apply<Vec4d, double>([&amd_vrd4_log](Vec4d x) -> Vec4d { return amd_vrd4_log(x); })},
-        {"log2", vec_func_apply<Vec4d, double>([&amd_vrd4_log2](Vec4d x) -> Vec4d { return amd_vrd4_log2(x); })},
-        {"exp", vec_func_apply<Vec4d, double>([&amd_vrd4_exp](Vec4d x) -> Vec4d { return amd_vrd4_exp(x); })},
-        {"exp2", vec_func_apply<Vec4d, double>([&amd_vrd4_exp2](Vec4d x) -> Vec4d { return amd_vrd4_exp2(x); })},
-        {"pow3.5",
-         vec_func_apply<Vec4d, double>([&amd_vrd4_pow](Vec4d x) -> Vec4d { return amd_vrd4_pow(x, Vec4d{3.5}); })},
-        {"pow13",
-         vec_func_apply<Vec4d, double>([&amd_vrd4_pow](Vec4d x) -> Vec4d { return amd_vrd4_pow(x, Vec4d{13}); })},
-    };
-
-    std::unordered_map<std::string, multi_eval_func<float>> amdlibm_funs_fx8 = {
-        {"sin", vec_func_apply<Vec8f, float>([&amd_vrs8_sinf](Vec8f x) -> Vec8f { return amd_vrs8_sinf(x); })},
-        {"cos", vec_func_apply<Vec8f, float>([&amd_vrs8_cosf](Vec8f x) -> Vec8f { return amd_vrs8_cosf(x); })},
-        {"tan", vec_func_apply<Vec8f, float>([&amd_vrs8_tanf](Vec8f x) -> Vec8f { return amd_vrs8_tanf(x); })},
-        {"log", vec_func_apply<Vec8f, float>([&amd_vrs8_logf](Vec8f x) -> Vec8f { return amd_vrs8_logf(x); })},
-        {"log2", vec_func_apply<Vec8f, float>([&amd_vrs8_log2f](Vec8f x) -> Vec8f { return amd_vrs8_log2f(x); })},
-        {"exp", vec_func_apply<Vec8f, float>([&amd_vrs8_expf](Vec8f x) -> Vec8f { return amd_vrs8_expf(x); })},
-        {"exp2", vec_func_apply<Vec8f, float>([&amd_vrs8_exp2f](Vec8f x) -> Vec8f { return amd_vrs8_exp2f(x); })},
-        {"pow3.5",
-         vec_func_apply<Vec8f, float>([&amd_vrs8_powf](Vec8f x) -> Vec8f { return amd_vrs8_powf(x, Vec8f{3.5}); })},
-        {"pow13",
-         vec_func_apply<Vec8f, float>([&amd_vrs8_powf](Vec8f x) -> Vec8f { return amd_vrs8_powf(x, Vec8f{13}); })},
-    };
-
-    std::unordered_map<std::string, multi_eval_func<float>> sleef_funs_fx1 = {
-        {"sin_pi", scalar_func_apply<float>([](float x) -> float { return Sleef_sinpif1_u05purecfma(x); })},
-        {"cos_pi", scalar_func_apply<float>([](float x) -> float { return Sleef_cospif1_u05purecfma(x); })},
-        {"sin", scalar_func_apply<float>([](float x) -> float { return Sleef_sinf1_u10purecfma(x); })},
-        {"cos", scalar_func_apply<float>([](float x) -> float { return Sleef_cosf1_u10purecfma(x); })},
-        {"tan", scalar_func_apply<float>([](float x) -> float { return Sleef_tanf1_u10purecfma(x); })},
-        {"sinh", scalar_func_apply<float>([](float x) -> float { return Sleef_sinhf1_u10purecfma(x); })},
-        {"cosh", scalar_func_apply<float>([](float x) -> float { return Sleef_coshf1_u10purecfma(x); })},
-        {"tanh", scalar_func_apply<float>([](float x) -> float { return Sleef_tanhf1_u10purecfma(x); })},
-        {"asin", scalar_func_apply<float>([](float x) -> float { return Sleef_asinf1_u10purecfma(x); })},
-        {"acos", scalar_func_apply<float>([](float x) -> float { return Sleef_acosf1_u10purecfma(x); })},
-        {"atan", scalar_func_apply<float>([](float x) -> float { return Sleef_atanf1_u10purecfma(x); })},
-        {"asinh", scalar_func_apply<float>([](float x) -> float { return Sleef_asinhf1_u10purecfma(x); })},
-        {"acosh", scalar_func_apply<float>([](float x) -> float { return Sleef_acoshf1_u10purecfma(x); })},
-        {"atanh", scalar_func_apply<float>([](float x) -> float { return Sleef_atanhf1_u10purecfma(x); })},
-        {"log", scalar_func_apply<float>([](float x) -> float { return Sleef_logf1_u10purecfma(x); })},
-        {"log2", scalar_func_apply<float>([](float x) -> float { return Sleef_log2f1_u10purecfma(x); })},
-        {"log10", scalar_func_apply<float>([](float x) -> float { return Sleef_log10f1_u10purecfma(x); })},
-        {"exp", scalar_func_apply<float>([](float x) -> float { return Sleef_expf1_u10purecfma(x); })},
-        {"exp2", scalar_func_apply<float>([](float x) -> float { return Sleef_exp2f1_u10purecfma(x); })},
-        {"exp10", scalar_func_apply<float>([](float x) -> float { return Sleef_exp10f1_u10purecfma(x); })},
-        {"erf", scalar_func_apply<float>([](float x) -> float { return Sleef_erff1_u10purecfma(x); })},
-        {"erfc", scalar_func_apply<float>([](float x) -> float { return Sleef_erfcf1_u15purecfma(x); })},
-        {"lgamma", scalar_func_apply<float>([](float x) -> float { return Sleef_lgammaf1_u10purecfma(x); })},
-        {"tgamma", scalar_func_apply<float>([](float x) -> float { return Sleef_tgammaf1_u10purecfma(x); })},
-        {"sqrt", scalar_func_apply<float>([](float x) -> float { return Sleef_sqrtf1_u05purecfma(x); })},
-        {"pow3.5", scalar_func_apply<float>([](float x) -> float { return Sleef_powf1_u10purecfma(x, 3.5); })},
-        {"pow13", scalar_func_apply<float>([](float x) -> float { return Sleef_powf1_u10purecfma(x, 13); })},
-    };
-
-    std::unordered_map<std::string, multi_eval_func<double>> sleef_funs_dx1 = {
-        {"sin_pi", scalar_func_apply<double>([](double x) -> double { return Sleef_sinpid1_u05purecfma(x); })},
-        {"cos_pi", scalar_func_apply<double>([](double x) -> double { return Sleef_cospid1_u05purecfma(x); })},
-        {"sin", scalar_func_apply<double>([](double x) -> double { return Sleef_sind1_u10purecfma(x); })},
-        {"cos", scalar_func_apply<double>([](double x) -> double { return Sleef_cosd1_u10purecfma(x); })},
-        {"tan", scalar_func_apply<double>([](double x) -> double { return Sleef_tand1_u10purecfma(x); })},
-        {"sinh", scalar_func_apply<double>([](double x) -> double { return Sleef_sinhd1_u10purecfma(x); })},
-        {"cosh", scalar_func_apply<double>([](double x) -> double { return Sleef_coshd1_u10purecfma(x); })},
-        {"tanh", scalar_func_apply<double>([](double x) -> double { return Sleef_tanhd1_u10purecfma(x); })},
-        {"asin", scalar_func_apply<double>([](double x) -> double { return Sleef_asind1_u10purecfma(x); })},
-        {"acos", scalar_func_apply<double>([](double x) -> double { return Sleef_acosd1_u10purecfma(x); })},
-        {"atan", scalar_func_apply<double>([](double x) -> double { return Sleef_atand1_u10purecfma(x); })},
-        {"asinh", scalar_func_apply<double>([](double x) -> double { return Sleef_asinhd1_u10purecfma(x); })},
-        {"acosh", scalar_func_apply<double>([](double x) -> double { return Sleef_acoshd1_u10purecfma(x); })},
-        {"atanh", scalar_func_apply<double>([](double x) -> double { return Sleef_atanhd1_u10purecfma(x); })},
-        {"log", scalar_func_apply<double>([](double x) -> double { return Sleef_logd1_u10purecfma(x); })},
-        {"log2", scalar_func_apply<double>([](double x) -> double { return Sleef_log2d1_u10purecfma(x); })},
-        {"log10", scalar_func_apply<double>([](double x) -> double { return Sleef_log10d1_u10purecfma(x); })},
-        {"exp", scalar_func_apply<double>([](double x) -> double { return Sleef_expd1_u10purecfma(x); })},
-        {"exp2", scalar_func_apply<double>([](double x) -> double { return Sleef_exp2d1_u10purecfma(x); })},
-        {"exp10", scalar_func_apply<double>([](double x) -> double { return Sleef_exp10d1_u10purecfma(x); })},
-        {"erf", scalar_func_apply<double>([](double x) -> double { return Sleef_erfd1_u10purecfma(x); })},
-        {"erfc", scalar_func_apply<double>([](double x) -> double { return Sleef_erfcd1_u15purecfma(x); })},
-        {"lgamma", scalar_func_apply<double>([](double x) -> double { return Sleef_lgammad1_u10purecfma(x); })},
-        {"tgamma", scalar_func_apply<double>([](double x) -> double { return Sleef_tgammad1_u10purecfma(x); })},
-        {"sqrt", scalar_func_apply<double>([](double x) -> double { return Sleef_sqrtd1_u05purecfma(x); })},
-        {"pow3.5", scalar_func_apply<double>([](double x) -> double { return Sleef_powd1_u10purecfma(x, 3.5); })},
-        {"pow13", scalar_func_apply<double>([](double x) -> double { return Sleef_powd1_u10purecfma(x, 13); })},
-    };
-
-    std::unordered_map<std::string, multi_eval_func<float>> sleef_funs_fx8 = {
-        {"sin_pi", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_sinpif8_u05avx2(x); })},
-        {"cos_pi", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_cospif8_u05avx2(x); })},
-        {"sin", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_sinf8_u10avx2(x); })},
-        {"cos", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_cosf8_u10avx2(x); })},
-        {"tan", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_tanf8_u10avx2(x); })},
-        {"sinh", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_sinhf8_u10avx2(x); })},
-        {"cosh", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_coshf8_u10avx2(x); })},
-        {"tanh", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_tanhf8_u10avx2(x); })},
-        {"asin", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_asinf8_u10avx2(x); })},
-        {"acos", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_acosf8_u10avx2(x); })},
-        {"atan", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_atanf8_u10avx2(x); })},
-        {"asinh", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_asinhf8_u10avx2(x); })},
-        {"acosh", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_acoshf8_u10avx2(x); })},
-        {"atanh", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_atanhf8_u10avx2(x); })},
-        {"log", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_logf8_u10avx2(x); })},
-        {"log2", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_log2f8_u10avx2(x); })},
-        {"log10", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_log10f8_u10avx2(x); })},
-        {"exp", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_expf8_u10avx2(x); })},
-        {"exp2", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_exp2f8_u10avx2(x); })},
-        {"exp10", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_exp10f8_u10avx2(x); })},
-        {"erf", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_erff8_u10avx2(x); })},
-        {"erfc", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_erfcf8_u15avx2(x); })},
-        {"lgamma", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_lgammaf8_u10avx2(x); })},
-        {"tlgamma", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_tgammaf8_u10avx2(x); })},
-        {"sqrt", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_sqrtf8_u05avx2(x); })},
-        {"pow3.5", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_powf8_u10avx2(x, Vec8f{3.5}); })},
-        {"pow13", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return Sleef_powf8_u10avx2(x, Vec8f{13}); })},
-    };
-
-    std::unordered_map<std::string, multi_eval_func<double>> sleef_funs_dx4 = {
-        {"sin_pi", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_sinpid4_u05avx2(x); })},
-        {"cos_pi", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_cospid4_u05avx2(x); })},
-        {"sin", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_sind4_u10avx2(x); })},
-        {"cos", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_cosd4_u10avx2(x); })},
-        {"tan", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_tand4_u10avx2(x); })},
-        {"sinh", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_sinhd4_u10avx2(x); })},
-        {"cosh", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_coshd4_u10avx2(x); })},
-        {"tanh", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_tanhd4_u10avx2(x); })},
-        {"asin", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_asind4_u10avx2(x); })},
-        {"acos", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_acosd4_u10avx2(x); })},
-        {"atan", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_atand4_u10avx2(x); })},
-        {"asinh", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_asinhd4_u10avx2(x); })},
-        {"acosh", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_acoshd4_u10avx2(x); })},
-        {"atanh", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_atanhd4_u10avx2(x); })},
-        {"log", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_logd4_u10avx2(x); })},
-        {"log2", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_log2d4_u10avx2(x); })},
-        {"log10", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_log10d4_u10avx2(x); })},
-        {"exp", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_expd4_u10avx2(x); })},
-        {"exp2", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_exp2d4_u10avx2(x); })},
-        {"exp10", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_exp10d4_u10avx2(x); })},
-        {"erf", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_erfd4_u10avx2(x); })},
-        {"erfc", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_erfcd4_u15avx2(x); })},
-        {"lgamma", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_lgammad4_u10avx2(x); })},
-        {"tlgamma", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_tgammad4_u10avx2(x); })},
-        {"sqrt", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_sqrtd4_u05avx2(x); })},
-        {"pow3.5", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_powd4_u10avx2(x, Vec4d{3.5}); })},
-        {"pow13", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return Sleef_powd4_u10avx2(x, Vec4d{13}); })},
-    };
-
-#ifdef __AVX512F__
-    std::unordered_map<std::string, multi_eval_func<float>> sleef_funs_fx16 = {
-        {"sin_pi", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_sinpif16_u05avx512f(x); })},
-        {"cos_pi", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_cospif16_u05avx512f(x); })},
-        {"sin", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_sinf16_u10avx512f(x); })},
-        {"cos", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_cosf16_u10avx512f(x); })},
-        {"tan", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_tanf16_u10avx512f(x); })},
-        {"sinh", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_sinhf16_u10avx512f(x); })},
-        {"cosh", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_coshf16_u10avx512f(x); })},
-        {"tanh", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_tanhf16_u10avx512f(x); })},
-        {"asin", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_asinf16_u10avx512f(x); })},
-        {"acos", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_acosf16_u10avx512f(x); })},
-        {"atan", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_atanf16_u10avx512f(x); })},
-        {"asinh", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_asinhf16_u10avx512f(x); })},
-        {"acosh", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_acoshf16_u10avx512f(x); })},
-        {"atanh", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_atanhf16_u10avx512f(x); })},
-        {"log", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_logf16_u10avx512f(x); })},
-        {"log2", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_log2f16_u10avx512f(x); })},
-        {"log10", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_log10f16_u10avx512f(x); })},
-        {"exp", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_expf16_u10avx512f(x); })},
-        {"exp2", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_exp2f16_u10avx512f(x); })},
-        {"exp10", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_exp10f16_u10avx512f(x); })},
-        {"erf", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_erff16_u10avx512f(x); })},
-        {"erfc", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_erfcf16_u15avx512f(x); })},
-        {"lgamma", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_lgammaf16_u10avx512f(x); })},
-        {"tlgamma", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_tgammaf16_u10avx512f(x); })},
-        {"sqrt", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_sqrtf16_u05avx512f(x); })},
-        {"pow3.5",
-         vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_powf16_u10avx512f(x, Vec16f{3.5}); })},
-        {"pow13",
-         vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return Sleef_powf16_u10avx512f(x, Vec16f{13}); })},
-    };
-
-    std::unordered_map<std::string, multi_eval_func<double>> sleef_funs_dx8 = {
-        {"sin_pi", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_sinpid8_u05avx512f(x); })},
-        {"cos_pi", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_cospid8_u05avx512f(x); })},
-        {"sin", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_sind8_u10avx512f(x); })},
-        {"cos", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_cosd8_u10avx512f(x); })},
-        {"tan", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_tand8_u10avx512f(x); })},
-        {"sinh", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_sinhd8_u10avx512f(x); })},
-        {"cosh", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_coshd8_u10avx512f(x); })},
-        {"tanh", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_tanhd8_u10avx512f(x); })},
-        {"asin", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_asind8_u10avx512f(x); })},
-        {"acos", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_acosd8_u10avx512f(x); })},
-        {"atan", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_atand8_u10avx512f(x); })},
-        {"asinh", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_asinhd8_u10avx512f(x); })},
-        {"acosh", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_acoshd8_u10avx512f(x); })},
-        {"atanh", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_atanhd8_u10avx512f(x); })},
-        {"log", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_logd8_u10avx512f(x); })},
-        {"log2", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_log2d8_u10avx512f(x); })},
-        {"log10", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_log10d8_u10avx512f(x); })},
-        {"exp", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_expd8_u10avx512f(x); })},
-        {"exp2", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_exp2d8_u10avx512f(x); })},
-        {"exp10", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_exp10d8_u10avx512f(x); })},
-        {"erf", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_erfd8_u10avx512f(x); })},
-        {"erfc", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_erfcd8_u15avx512f(x); })},
-        {"lgamma", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_lgammad8_u10avx512f(x); })},
-        {"tlgamma", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_tgammad8_u10avx512f(x); })},
-        {"sqrt", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_sqrtd8_u05avx512f(x); })},
-        {"pow3.5",
-         vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_powd8_u10avx512f(x, Vec8d{3.5}); })},
-        {"pow13", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return Sleef_powd8_u10avx512f(x, Vec8d{13}); })},
-    };
-#endif
-
-    std::unordered_map<std::string, multi_eval_func<float>> af_funs_fx8 = {
-        {"sqrt", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return sqrt(x); })},
-        {"sin", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return sin(x); })},
-        {"cos", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return cos(x); })},
-        {"tan", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return tan(x); })},
-        {"sinh", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return sinh(x); })},
-        {"cosh", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return cosh(x); })},
-        {"tanh", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return tanh(x); })},
-        {"asinh", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return asinh(x); })},
-        {"acosh", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return acosh(x); })},
-        {"atanh", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return atanh(x); })},
-        {"asin", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return asin(x); })},
-        {"acos", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return acos(x); })},
-        {"atan", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return atan(x); })},
-        {"exp", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return exp(x); })},
-        {"exp2", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return exp2(x); })},
-        {"exp10", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return exp10(x); })},
-        {"log", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return log(x); })},
-        {"log2", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return log2(x); })},
-        {"log10", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return log10(x); })},
-        {"pow3.5", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return pow(x, 3.5); })},
-        {"pow13", vec_func_apply<Vec8f, float>([](Vec8f x) -> Vec8f { return pow_const(x, 13); })},
-    };
-
-    std::unordered_map<std::string, multi_eval_func<double>> af_funs_dx4 = {
-        {"sqrt", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return sqrt(x); })},
-        {"sin", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return sin(x); })},
-        {"cos", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return cos(x); })},
-        {"tan", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return tan(x); })},
-        {"sinh", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return sinh(x); })},
-        {"cosh", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return cosh(x); })},
-        {"tanh", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return tanh(x); })},
-        {"asinh", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return asinh(x); })},
-        {"acosh", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return acosh(x); })},
-        {"atanh", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return atanh(x); })},
-        {"asin", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return asin(x); })},
-        {"acos", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return acos(x); })},
-        {"atan", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return atan(x); })},
-        {"exp", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return exp(x); })},
-        {"exp2", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return exp2(x); })},
-        {"exp10", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return exp10(x); })},
-        {"log", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return log(x); })},
-        {"log2", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return log2(x); })},
-        {"log10", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return log10(x); })},
-        {"pow3.5", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return pow(x, 3.5); })},
-        {"pow13", vec_func_apply<Vec4d, double>([](Vec4d x) -> Vec4d { return pow_const(x, 13); })},
-    };
-
-#ifdef __AVX512F__
-    std::unordered_map<std::string, multi_eval_func<float>> af_funs_fx16 = {
-        {"sqrt", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return sqrt(x); })},
-        {"sin", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return sin(x); })},
-        {"cos", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return cos(x); })},
-        {"tan", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return tan(x); })},
-        {"sinh", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return sinh(x); })},
-        {"cosh", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return cosh(x); })},
-        {"tanh", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return tanh(x); })},
-        {"asinh", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return asinh(x); })},
-        {"acosh", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return acosh(x); })},
-        {"atanh", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return atanh(x); })},
-        {"asin", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return asin(x); })},
-        {"acos", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return acos(x); })},
-        {"atan", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return atan(x); })},
-        {"exp", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return exp(x); })},
-        {"exp2", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return exp2(x); })},
-        {"exp10", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return exp10(x); })},
-        {"log", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return log(x); })},
-        {"log2", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return log2(x); })},
-        {"log10", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return log10(x); })},
-        {"pow3.5", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return pow(x, 3.5); })},
-        {"pow13", vec_func_apply<Vec16f, float>([](Vec16f x) -> Vec16f { return pow_const(x, 13); })},
-    };
-
-    std::unordered_map<std::string, multi_eval_func<double>> af_funs_dx8 = {
-        {"sqrt", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return sqrt(x); })},
-        {"sin", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return sin(x); })},
-        {"cos", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return cos(x); })},
-        {"tan", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return tan(x); })},
-        {"sinh", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return sinh(x); })},
-        {"cosh", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return cosh(x); })},
-        {"tanh", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return tanh(x); })},
-        {"asinh", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return asinh(x); })},
-        {"acosh", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return acosh(x); })},
-        {"atanh", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return atanh(x); })},
-        {"asin", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return asin(x); })},
-        {"acos", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return acos(x); })},
-        {"atan", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return atan(x); })},
-        {"exp", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return exp(x); })},
-        {"exp2", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return exp2(x); })},
-        {"exp10", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return exp10(x); })},
-        {"log", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return log(x); })},
-        {"log2", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return log2(x); })},
-        {"log10", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return log10(x); })},
-        {"pow3.5", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return pow(x, 3.5); })},
-        {"pow13", vec_func_apply<Vec8d, double>([](Vec8d x) -> Vec8d { return pow_const(x, 13); })},
-    };
-#endif
-
-    std::unordered_map<std::string, multi_eval_func<float>> sctl_funs_fx8 = {
-        {"copy", sctl_apply<float, 8>([](const sctl_fx8 &x) { return x; })},
-        {"exp", sctl_apply<float, 8>([](const sctl_fx8 &x) { return sctl::approx_exp<7>(x); })},
-        {"sin", sctl_apply<float, 8>([](const sctl_fx8 &x) {
-             sctl_fx8 sinx, cosx;
-             sctl::approx_sincos<7>(sinx, cosx, x);
-             return sinx;
-         })},
-        {"cos", sctl_apply<float, 8>([](const sctl_fx8 &x) {
-             sctl_fx8 sinx, cosx;
-             sctl::approx_sincos<7>(sinx, cosx, x);
-             return cosx;
-         })},
-        {"rsqrt", sctl_apply<float, 8>([](const sctl_fx8 &x) { return sctl::approx_rsqrt<7>(x); })},
-    };
-
-    std::unordered_map<std::string, multi_eval_func<double>> sctl_funs_dx4 = {
-        {"copy", sctl_apply<double, 4>([](const sctl_dx4 &x) { return x; })},
-        {"exp", sctl_apply<double, 4>([](const sctl_dx4 &x) { return sctl::approx_exp<16>(x); })},
-        {"sin", sctl_apply<double, 4>([](const sctl_dx4 &x) {
-             sctl_dx4 sinx, cosx;
-             sctl::approx_sincos<16>(sinx, cosx, x);
-             return sinx;
-         })},
-        {"cos", sctl_apply<double, 4>([](const sctl_dx4 &x) {
-             sctl_dx4 sinx, cosx;
-             sctl::approx_sincos<16>(sinx, cosx, x);
-             return cosx;
-         })},
-        {"rsqrt", sctl_apply<double, 4>([](const sctl_dx4 &x) { return sctl::approx_rsqrt<16>(x); })},
-    };
-
-    std::unordered_map<std::string, multi_eval_func<float>> sctl_funs_fx16 = {
-        {"copy", sctl_apply<float, 16>([](const sctl_fx16 &x) { return x; })},
-        {"exp", sctl_apply<float, 16>([](const sctl_fx16 &x) { return sctl::approx_exp<7>(x); })},
-        {"sin", sctl_apply<float, 16>([](const sctl_fx16 &x) {
-             sctl_fx16 sinx, cosx;
-             sctl::approx_sincos<7>(sinx, cosx, x);
-             return sinx;
-         })},
-        {"cos", sctl_apply<float, 16>([](const sctl_fx16 &x) {
-             sctl_fx16 sinx, cosx;
-             sctl::approx_sincos<7>(sinx, cosx, x);
-             return cosx;
-         })},
-        {"rsqrt", sctl_apply<float, 16>([](const sctl_fx16 &x) { return sctl::approx_rsqrt<7>(x); })},
-    };
-
-    std::unordered_map<std::string, multi_eval_func<double>> sctl_funs_dx8 = {
-        {"copy", sctl_apply<double, 8>([](const sctl_dx8 &x) { return x; })},
-        {"exp", sctl_apply<double, 8>([](const sctl_dx8 &x) { return sctl::approx_exp<16>(x); })},
-        {"sin", sctl_apply<double, 8>([](const sctl_dx8 &x) {
-             sctl_dx8 sinx, cosx;
-             sctl::approx_sincos<16>(sinx, cosx, x);
-             return sinx;
-         })},
-        {"cos", sctl_apply<double, 8>([](const sctl_dx8 &x) {
-             sctl_dx8 sinx, cosx;
-             sctl::approx_sincos<16>(sinx, cosx, x);
-             return cosx;
-         })},
-        {"rsqrt", sctl_apply<double, 8>([](const sctl_dx8 &x) { return sctl::approx_rsqrt<16>(x); })},
-    };
-
-    std::unordered_map<std::string, OPS::OPS> eigen_funs = {
-        {"sin", OPS::SIN},         {"cos", OPS::COS},      {"tan", OPS::TAN},     {"sinh", OPS::SINH},
-        {"cosh", OPS::COSH},       {"tanh", OPS::TANH},    {"exp", OPS::EXP},     {"log", OPS::LOG},
-        {"log10", OPS::LOG10},     {"pow3.5", OPS::POW35}, {"pow13", OPS::POW13}, {"asin", OPS::ASIN},
-        {"acos", OPS::ACOS},       {"atan", OPS::ATAN},    {"asinh", OPS::ASINH}, {"atanh", OPS::ATANH},
-        {"acosh", OPS::ACOSH},     {"erf", OPS::ERF},      {"erfc", OPS::ERFC},   {"lgamma", OPS::LGAMMA},
-        {"digamma", OPS::DIGAMMA}, {"ndtri", OPS::NDTRI},  {"sqrt", OPS::SQRT},   {"rsqrt", OPS::RSQRT},
+    for (auto &[name, domain] : config.domains) {
+        params[name].domain = domain;
+        params[name].user_domain = true;
+    }
+    for (auto &[name, domain] : config.domains2)
+        params[name].domain2 = domain;
+
+    // Range reduction octants, and the switches between the small argument and asymptotic expansions
+    const std::unordered_map<std::string, std::vector<double>> cutoffs = {
+        {"sin", {M_PI / 4, M_PI / 2, 3 * M_PI / 4, M_PI, 5 * M_PI / 4, 3 * M_PI / 2, 7 * M_PI / 4}},
+        {"cos", {M_PI / 4, M_PI / 2, 3 * M_PI / 4, M_PI, 5 * M_PI / 4, 3 * M_PI / 2, 7 * M_PI / 4}},
+        {"tan", {M_PI / 4, M_PI / 2, 3 * M_PI / 4, M_PI, 5 * M_PI / 4, 3 * M_PI / 2, 7 * M_PI / 4}},
+        {"asin", {-0.5, 0.5}},
+        {"acos", {-0.5, 0.5}},
+        {"atan", {-1.0, 1.0}},
+        {"erf", {-0.84375, 0.84375}},
+        {"erfc", {-0.84375, 0.84375}},
+        {"log", {1.0}},
+        {"bessel_J0", {4.0, 8.0}},
+        {"bessel_J1", {4.0, 8.0}},
+        {"bessel_Y0", {4.0, 8.0}},
+        {"bessel_Y1", {4.0, 8.0}},
+        {"bessel_Y2", {4.0, 8.0}},
     };
+    for (auto &[name, points] : cutoffs)
+        params[name].cutoffs = points;
+    for (auto &[name, points] : config.cutoffs)
+        params[name].cutoffs = points;
+    // Fused keys run on the domain and cutoffs of their first output, unless the config sets their own
+    for (const auto &[key, outputs] : fused_outputs()) {
+        if (!params[key].user_domain)
+            params[key].domain = params[outputs.first].domain;
+        if (params[key].cutoffs.empty())
+            params[key].cutoffs = params[outputs.first].cutoffs;
+    }
 
-    std::set<std::string> fun_union;
-    for (auto kv : amdlibm_funs_fx1)
-        fun_union.insert(kv.first);
-    for (auto kv : amdlibm_funs_dx1)
-        fun_union.insert(kv.first);
-    for (auto kv : boost_funs_fx1)
-        fun_union.insert(kv.first);
-    for (auto kv : boost_funs_dx1)
-        fun_union.insert(kv.first);
-    for (auto kv : eigen_funs)
-        fun_union.insert(kv.first);
-    for (auto kv : fort_funs)
-        fun_union.insert(kv.first);
-    for (auto kv : gsl_funs)
-        fun_union.insert(kv.first);
-    for (auto kv : gsl_complex_funs)
-        fun_union.insert(kv.first);
-    for (auto kv : hank10x_funs)
-        fun_union.insert(kv.first);
-    for (auto kv : sleef_funs_fx1)
-        fun_union.insert(kv.first);
-    for (auto kv : sleef_funs_dx1)
-        fun_union.insert(kv.first);
-    for (auto kv : std_funs_fx1)
-        fun_union.insert(kv.first);
-    for (auto kv : std_funs_dx1)
-        fun_union.insert(kv.first);
-
-    for (auto kv : af_funs_dx4)
-        fun_union.insert(kv.first);
-    for (auto kv : amdlibm_funs_dx4)
-        fun_union.insert(kv.first);
-    for (auto kv : amdlibm_funs_fx8)
-        fun_union.insert(kv.first);
-    for (auto kv : sctl_funs_dx4)
-        fun_union.insert(kv.first);
-    for (auto kv : sleef_funs_dx4)
-        fun_union.insert(kv.first);
-    for (auto kv : sleef_funs_fx8)
-        fun_union.insert(kv.first);
-#ifdef __AVX512F__
-    for (auto kv : af_funs_dx8)
-        fun_union.insert(kv.first);
-    for (auto kv : sctl_funs_dx8)
-        fun_union.insert(kv.first);
-    for (auto kv : sleef_funs_dx8)
-        fun_union.insert(kv.first);
-    for (auto kv : sleef_funs_fx16)
-        fun_union.insert(kv.first);
-#endif
+    // --inputs=uniform|log-uniform|normal|cutoffs|trace=FILE: distribution of the real inputs over each domain
+    std::string input_spec = config.inputs;
+    if (flags.count("inputs"))
+        input_spec = flags["inputs"];
+    const InputDist input_dist = input_spec.empty() ? InputDist() : InputDist(input_spec);
+    if (!input_spec.empty())
+        base_opts.inputs = &input_dist;
+
+    // --order=shuffled|sorted|compare: real inputs as drawn, in ascending order, or both, reporting sorted Mevals/s
+    const std::string order = flags.count("order") ? flags["order"] : config.order.empty() ? "shuffled" : config.order;
+    if (order != "shuffled" && order != "sorted" && order != "compare")
+        throw std::runtime_error("Unknown input order '" + order + "', expected shuffled, sorted or compare");
+    base_opts.sorted = order == "sorted";
+    base_opts.compare_sorted = order == "compare";
+
+    KernelRegistry registry = build_registry(isas);
+    if (flags.count("list")) {
+        print_registry(std::cout, registry);
+        return 0;
+    }
+    const std::set<std::string> fun_union = registry.functions();
 
     std::set<std::string> keys_to_eval;
     if (input_keys.size() > 0)
@@ -1182,8 +1634,13 @@ int main(int argc, char *argv[]) {
                               std::inserter(keys_to_eval, keys_to_eval.end()));
     else
         keys_to_eval = fun_union;
+    // --roofline: before the functions of every run set and thread count, time the roofline entries (stream_copy and
+    // stream_scale bandwidth, fma_peak FMA rate) of every tier, and report each entry against the best of them
+    const std::vector<std::string> roofline_keys = {"stream_copy", "stream_scale", "fma_peak"};
+    for (const auto &key : roofline_keys)
+        keys_to_eval.erase(key);
+    const bool roofline = flags.count("roofline");
 
-    std::unordered_map<std::string, std::shared_ptr<baobzi::Baobzi>> baobzi_funs;
     std::unordered_map<std::string, std::function<double(double)>> potential_baobzi_funs{
         {"bessel_Y0", [](double x) -> double { return gsl_sf_bessel_Y0(x); }},
         {"bessel_Y1", [](double x) -> double { return gsl_sf_bessel_Y1(x); }},
@@ -1200,58 +1657,265 @@ int main(int argc, char *argv[]) {
         {"hermite_3", [](double x) -> double { return gsl_sf_hermite(3, x); }},
     };
 
+    // --baobzi-sweep: fit every Baobzi candidate over a grid of orders and tolerances, report fit cost, size, speed
+    // and error, and exit
+    if (flags.count("baobzi-sweep")) {
+        const int n_eval = 1 << 20;
+        Eigen::VectorXd vals = 0.5 * (Eigen::ArrayXd::Random(n_eval) + 1.0);
+        RunOptions opts = base_opts;
+        if (!opts.n_accuracy)
+            opts.n_accuracy = 1 << 14;
+        for (auto &key : keys_to_eval)
+            if (potential_baobzi_funs.count(key))
+                baobzi_sweep(std::cout, key, potential_baobzi_funs.at(key), params, vals,
+                             {registry.find<multi_eval_func<double>>("gsl_dx1"),
+                              registry.find<multi_eval_func<double>>("boost_dx1")},
+                             opts);
+        return 0;
+    }
+
+    // --baobzi-cache[=dir]: keep fitted approximants on disk and restore them on later runs
+    std::string baobzi_cache_dir = config.baobzi_cache;
+    if (flags.count("baobzi-cache"))
+        baobzi_cache_dir = flags["baobzi-cache"].empty() ? "baobzi_cache" : flags["baobzi-cache"];
+    const std::string baobzi_version = baobzi_cache_dir.empty() ? "" : probe_version(get_baobzi_version);
+
+    for (auto &key : keys_to_eval) {
+        if (potential_baobzi_funs.count(key)) {
+            const auto &domain = params[key].domain;
+            std::string cache_file;
+            if (!baobzi_cache_dir.empty())
+                cache_file = baobzi_cache_file(baobzi_cache_dir, key, domain, 8, 1E-10, baobzi_version);
+            if (!cache_file.empty() && std::filesystem::exists(cache_file))
+                std::cerr << "Loading baobzi function '" + key + "' from " + cache_file + ".\n";
+            else
+                std::cerr << "Creating baobzi function '" + key + "'.\n";
+            registry.dx("baobzi_dx1")[key] =
+                baobzi_eval(create_baobzi_func((void *)(&potential_baobzi_funs.at(key)), domain, cache_file));
+        }
+    }
+
+    // The same candidates as baobzi-simd entries: the same order and tolerance, fitted by fit_leaf_table into a flat
+    // layout that the vector kernels of each tier search and gather from lane by lane
+    leaf_table_map leaf_tables;
     for (auto &key : keys_to_eval) {
         if (potential_baobzi_funs.count(key)) {
-            std::cerr << "Creating baobzi function '" + key + "'.\n";
-            baobzi_funs[key] = create_baobzi_func((void *)(&potential_baobzi_funs.at(key)), params[key].domain);
+            const struct timespec st = get_wtime();
+            LeafTable leaf_table = fit_leaf_table(potential_baobzi_funs.at(key), params[key].domain, 8, 1E-10);
+            const struct timespec ft = get_wtime();
+            leaf_table.fit_time = get_wtime_diff(&st, &ft);
+            leaf_tables[key] = std::make_shared<const LeafTable>(std::move(leaf_table));
+        }
+    }
+    add_leaf_kernels(registry, isas, "baobzi-simd", leaf_tables);
+
+    // --baobzi-bucket: baobzi and baobzi-simd again, on their inputs grouped by leaf (of the baobzi-simd fit) and put
+    // back in order afterwards, as baobzi-bucketed and baobzi-simd-bucketed
+    if (flags.count("baobzi-bucket")) {
+        std::vector<KernelTable<multi_eval_func<double>>> originals;
+        for (const auto &table : registry.tables<multi_eval_func<double>>()) {
+            const std::string library = EntrySpec(table.prefix).library;
+            if (library == "baobzi" || library == "baobzi-simd")
+                originals.push_back(table);
+        }
+        for (const auto &original : originals) {
+            const std::string library = EntrySpec(original.prefix).library;
+            auto &bucketed = registry.table<multi_eval_func<double>>(library + "-bucketed" +
+                                                                     original.prefix.substr(library.size()));
+            bucketed.isa = original.isa;
+            bucketed.domains = original.domains;
+            bucketed.setup_times = original.setup_times;
+            for (const auto &[key, fun] : original.funs)
+                if (leaf_tables.count(key))
+                    bucketed.funs[key] = leaf_bucketed(fun, leaf_tables.at(key));
+        }
+    }
+
+    // --remez[=tol]: minimax polynomial and rational fits of the Baobzi candidates and a few elementary functions on
+    // their domains, with the lowest degree that meets tol (default 1e-10), as the remez and remez-rational entries
+    double remez_tol = config.remez_tol;
+    if (flags.count("remez"))
+        remez_tol = flags["remez"].empty() ? 1E-10 : std::stod(flags["remez"]);
+    if (remez_tol > 0) {
+        auto potential_remez_funs = potential_baobzi_funs;
+        potential_remez_funs.insert({
+            {"erf", [](double x) -> double { return std::erf(x); }},
+            {"erfc", [](double x) -> double { return std::erfc(x); }},
+            {"exp", [](double x) -> double { return std::exp(x); }},
+            {"log", [](double x) -> double { return std::log(x); }},
+            {"sin", [](double x) -> double { return std::sin(x); }},
+            {"cos", [](double x) -> double { return std::cos(x); }},
+        });
+
+        approximation_map polys, rationals;
+        for (auto &key : keys_to_eval) {
+            if (!potential_remez_funs.count(key))
+                continue;
+            const auto &domain = params[key].domain;
+            const struct timespec st = get_wtime();
+            const RemezFitter fitter(potential_remez_funs.at(key), domain);
+            const struct timespec ft = get_wtime();
+            const double grid_time = get_wtime_diff(&st, &ft);
+            for (bool rational : {false, true}) {
+                const struct timespec st = get_wtime();
+                auto fit = fitter.fit_to_tolerance(remez_tol, rational);
+                const struct timespec ft = get_wtime();
+                const std::string kind = rational ? "rational" : "polynomial";
+                if (!fit) {
+                    std::cerr << "No remez " << kind << " of '" << key << "' up to degree "
+                              << (rational ? max_rational_degree : max_poly_degree) << " meets " << remez_tol << " on ["
+                              << domain.first << ", " << domain.second << "].\n";
+                    continue;
+                }
+                fit->fit_time = grid_time + get_wtime_diff(&st, &ft);
+                std::cerr << "Fitted remez " << kind << " of '" << key << "' of degree " << fit->p.size() - 1
+                          << ", max " << (fit->relative ? "rel" : "abs") << " error " << fit->max_err << ".\n";
+                (rational ? rationals : polys)[key] = *fit;
+            }
         }
+        add_approx_kernels(registry, isas, "remez", polys);
+        add_approx_kernels(registry, isas, "remez-rational", rationals);
+    }
+
+    std::vector<std::pair<int, int>> run_sets = {{1024, 1e4}, {1024 * 1e4, 1}};
+    if (!config.run_sets.empty())
+        run_sets = config.run_sets;
+
+    // --size-sweep: small and odd lengths, where the vector remainder handling dominates, at ~1e6 evals per entry
+    if (flags.count("size-sweep")) {
+        run_sets.clear();
+        for (int n_eval = 1; n_eval <= 64; ++n_eval)
+            run_sets.push_back({n_eval, 1e6 / n_eval});
+        for (int n_eval : {65, 100, 127, 128, 129, 255, 256, 257, 1000, 1023, 1024, 1025})
+            run_sets.push_back({n_eval, 1e6 / n_eval});
+    }
+
+    // --sweep[=min[:max[:factor]]]: geometric sweep of lengths across the cache levels, with the repeat count chosen
+    // so that every length does about --sweep-evals (default 2^24) evaluations per entry
+    if (flags.count("sweep")) {
+        double sweep_min = 256, sweep_max = 64 * 1024 * 1024, sweep_factor = 2.0;
+        std::stringstream ss(flags["sweep"]);
+        std::string field;
+        for (double *p : {&sweep_min, &sweep_max, &sweep_factor})
+            if (std::getline(ss, field, ':') && !field.empty())
+                *p = std::stod(field);
+        if (!(sweep_min >= 1 && sweep_min <= sweep_max && std::isfinite(sweep_max) && sweep_factor > 1))
+            throw std::runtime_error("Sweep '" + flags["sweep"] + "' needs 1 <= min <= max and a factor above 1");
+        const double sweep_evals = flags.count("sweep-evals") ? std::stod(flags["sweep-evals"]) : 1 << 24;
+
+        run_sets.clear();
+        // At least one longer per step, factors close to 1 would round back to the same length
+        for (double n_eval = sweep_min; n_eval <= sweep_max;
+             n_eval = std::max(n_eval + 1, std::ceil(n_eval * sweep_factor)))
+            run_sets.push_back({n_eval, std::max(1.0, std::round(sweep_evals / n_eval))});
+    }
+
+    // --arena[=thp|hugetlb|FILE]: inputs and results of every entry in one mapping, faulted in once and sized for the
+    // longest run set, instead of buffers allocated (and faulted in) per entry
+    std::string arena_backing = config.arena;
+    if (flags.count("arena"))
+        arena_backing = flags["arena"].empty() ? "thp" : flags["arena"];
+    std::unique_ptr<Arena> arena;
+    if (!arena_backing.empty()) {
+        std::size_t max_n_eval = 0;
+        for (const auto &[n_eval, n_repeat] : run_sets)
+            max_n_eval = std::max<std::size_t>(max_n_eval, n_eval);
+        arena = std::make_unique<Arena>(max_n_eval * sizeof(cdouble), 2 * max_n_eval * sizeof(cdouble), arena_backing);
+        base_opts.arena = arena.get();
+    }
+
+    // --csv=FILE, --json=FILE: also write every entry, with a metadata header, as CSV and/or JSON lines
+    BenchLog out(std::cout);
+    if (flags.count("csv") || flags.count("json")) {
+        BenchLog::Metadata metadata = get_metadata();
+        std::string isa_names;
+        for (ISA isa : isas)
+            isa_names += std::string(isa_names.empty() ? "" : ",") + isa_name(isa);
+        metadata.push_back({"isa", isa_names});
+        metadata.push_back({"inputs", input_dist.name});
+        metadata.push_back({"order", order});
+        metadata.push_back({"arena", arena_backing.empty() ? "none" : arena_backing});
+        metadata.push_back({"pin", pin});
+        metadata.push_back({"numa_nodes", std::to_string(topology.n_nodes())});
+        if (flags.count("csv"))
+            out.open_csv(flags["csv"], metadata);
+        if (flags.count("json"))
+            out.open_json(flags["json"], metadata);
     }
 
-    const std::vector<std::pair<int, int>> run_sets = {{1024, 1e4}, {1024 * 1e4, 1}};
     for (auto &run_set : run_sets) {
         const auto &[n_eval, n_repeat] = run_set;
         std::cerr << "Running benchmark with input vector of length " << n_eval << " and " << n_repeat << " repeats.\n";
+        out.n_eval = n_eval;
         Eigen::VectorXd vals = 0.5 * (Eigen::ArrayXd::Random(n_eval) + 1.0);
         Eigen::VectorXf fvals = vals.cast<float>();
         Eigen::VectorX<cdouble> cvals = 0.5 * (Eigen::ArrayX<cdouble>::Random(n_eval) + std::complex<double>{1.0, 1.0});
+        // Both arguments of the two-argument entries, back to back
+        Eigen::VectorXd vals_xy(2 * n_eval);
+        vals_xy << vals, 0.5 * (Eigen::VectorXd::Random(n_eval).array() + 1.0);
+        Eigen::VectorXf fvals_xy = vals_xy.cast<float>();
+
+        // Every tier of the roofline entries, whatever the library and width filters
+        for (int n_threads : roofline ? thread_counts : std::vector<int>()) {
+            RunOptions opts = base_opts;
+            opts.n_threads = n_threads;
+            opts.libraries.clear();
+            opts.vector_widths.clear();
+            opts.n_accuracy = 0;
+            opts.compare_sorted = false;
+            for (const auto &key : roofline_keys) {
+                run_tables(out, key, registry.tables<multi_eval_func<float>>(), params, fvals, n_repeat, opts);
+                run_tables(out, key, registry.tables<multi_eval_func<double>>(), params, vals, n_repeat, opts);
+            }
+            out << "\n";
+        }
 
         for (auto key : keys_to_eval) {
-            std::cout << test_func(key, "boost_fx1", boost_funs_fx1, params, fvals, n_repeat);
-            std::cout << test_func(key, "std_fx1", std_funs_fx1, params, fvals, n_repeat);
-            std::cout << test_func(key, "amdlibm_fx1", amdlibm_funs_fx1, params, fvals, n_repeat);
-            std::cout << test_func(key, "amdlibm_fx8", amdlibm_funs_fx8, params, fvals, n_repeat);
-            std::cout << test_func(key, "sleef_fx1", sleef_funs_fx1, params, fvals, n_repeat);
-            std::cout << test_func(key, "sleef_fx8", sleef_funs_fx8, params, fvals, n_repeat);
-            std::cout << test_func(key, "af_fx8", af_funs_fx8, params, fvals, n_repeat);
-            std::cout << test_func(key, "sctl_fx8", sctl_funs_fx8, params, fvals, n_repeat);
-            std::cout << test_func(key, "eigen_fxx", eigen_funs, params, fvals, n_repeat);
-#ifdef __AVX512F__
-            std::cout << test_func(key, "agnerfog_fx16", af_funs_fx16, params, fvals, n_repeat);
-            std::cout << test_func(key, "sctl_fx16", sctl_funs_fx16, params, fvals, n_repeat);
-            std::cout << test_func(key, "sleef_fx16", sleef_funs_fx16, params, fvals, n_repeat);
-#endif
+            for (int n_threads : thread_counts) {
+                RunOptions opts = base_opts;
+                opts.n_threads = n_threads;
+                run_tables(out, key, registry.tables<multi_eval_func<float>>(), params, fvals, n_repeat, opts);
+                run_tables(out, key, registry.tables<multi_eval_func<double>>(), params, vals, n_repeat, opts);
+                run_tables(out, key, registry.tables<multi_eval_func<cdouble>>(), params, cvals, n_repeat, opts);
+                run_tables(out, key, registry.tables<multi_eval_func2<float>>(), params, fvals_xy, n_repeat, opts);
+                run_tables(out, key, registry.tables<multi_eval_func2<double>>(), params, vals_xy, n_repeat, opts);
+                run_tables(out, key, registry.tables<multi_eval_func_x2<float>>(), params, fvals, n_repeat, opts);
+                run_tables(out, key, registry.tables<multi_eval_func_x2<double>>(), params, vals, n_repeat, opts);
+                run_tables(out, key, registry.tables<fun_cdx1_x2>(), params, cvals, n_repeat, opts);
+                run_tables(out, key, registry.tables<soa_eval_func_cdx_x2>(), params, cvals, n_repeat, opts);
+                run_tables(out, key, registry.tables<multi_eval_loop<float>>(), params, fvals, n_repeat, opts);
+                run_tables(out, key, registry.tables<multi_eval_loop<double>>(), params, vals, n_repeat, opts);
+                run_tables(out, key, registry.tables<eval_loop_cdx1_x2>(), params, cvals, n_repeat, opts);
+                out << "\n";
+            }
+        }
+    }
 
-            std::cout << test_func(key, "std_dx1", std_funs_dx1, params, vals, n_repeat);
-            std::cout << test_func(key, "fort_dx1", fort_funs, params, vals, n_repeat);
-            std::cout << test_func(key, "amdlibm_dx1", amdlibm_funs_dx1, params, vals, n_repeat);
-            std::cout << test_func(key, "boost_dx1", boost_funs_dx1, params, vals, n_repeat);
-            std::cout << test_func(key, "gsl_dx1", gsl_funs, params, vals, n_repeat);
-            std::cout << test_func(key, "gsl_cdx1", gsl_complex_funs, params, cvals, n_repeat);
-            std::cout << test_func(key, "sleef_dx1", sleef_funs_dx1, params, vals, n_repeat);
-            std::cout << test_func(key, "hank10x_dx1", hank10x_funs, params, cvals, n_repeat);
-            std::cout << test_func(key, "baobzi_dx1", baobzi_funs, params, vals, n_repeat);
-            std::cout << test_func(key, "eigen_dxx", eigen_funs, params, vals, n_repeat);
-            std::cout << test_func(key, "amdlibm_dx4", amdlibm_funs_dx4, params, vals, n_repeat);
-            std::cout << test_func(key, "agnerfog_dx4", af_funs_dx4, params, vals, n_repeat);
-            std::cout << test_func(key, "sctl_dx4", sctl_funs_dx4, params, vals, n_repeat);
-            std::cout << test_func(key, "sleef_dx4", sleef_funs_dx4, params, vals, n_repeat);
-#ifdef __AVX512F__
-            std::cout << test_func(key, "agnerfog_dx8", af_funs_dx8, params, vals, n_repeat);
-            std::cout << test_func(key, "sctl_dx8", sctl_funs_dx8, params, vals, n_repeat);
-            std::cout << test_func(key, "sleef_dx8", sleef_funs_dx8, params, vals, n_repeat);
-#endif
-            std::cout << "\n";
+    if (flags.count("size-sweep") || flags.count("sweep"))
+        print_sweep(std::cout, out.records);
+
+    if (n_latency_calls) {
+        std::cerr << "Running latency benchmark with chains of " << n_latency_calls << " dependent calls.\n";
+        out << "ns/call\n";
+        out.n_eval = 1;
+        Eigen::VectorXd vals = 0.5 * (Eigen::ArrayXd::Random(max_latency_width) + 1.0);
+        Eigen::VectorXf fvals = vals.cast<float>();
+        const auto copy_fx1 = scalar_func_apply<float>([](float x) -> float { return x; });
+        const auto copy_dx1 = scalar_func_apply<double>([](double x) -> double { return x; });
+
+        for (auto key : keys_to_eval) {
+            const std::size_t n = n_latency_calls;
+            std::unordered_map<std::string, multi_eval_func<float>> overhead_fx1 = {{key, copy_fx1}};
+            std::unordered_map<std::string, multi_eval_func<double>> overhead_dx1 = {{key, copy_dx1}};
+
+            out << test_latency(key, "copy_fx1", overhead_fx1, params, fvals, n, 1, base_opts);
+            run_latency_tables(out, key, registry.tables<multi_eval_func<float>>(), params, fvals, n, base_opts);
+
+            out << test_latency(key, "copy_dx1", overhead_dx1, params, vals, n, 1, base_opts);
+            run_latency_tables(out, key, registry.tables<multi_eval_func<double>>(), params, vals, n, base_opts);
+            out << "\n";
         }
     }
+
     return 0;
 }
@@ -0,0 +1,31 @@
+# Runs BENCH with tests/vector_width.toml and --csv, then checks that the vector_width column of every entry is the
+# lane count of its label, <library>_<precision>x<width>_<function>
+execute_process(COMMAND ${BENCH} --config=${CONFIG} --csv=${CSV} RESULT_VARIABLE status OUTPUT_QUIET)
+if(NOT status EQUAL 0)
+  message(FATAL_ERROR "${BENCH} --config=${CONFIG} --csv=${CSV} failed: ${status}")
+endif()
+
+file(STRINGS ${CSV} lines)
+set(n_vector 0)
+foreach(line IN LISTS lines)
+  if(line MATCHES "^#" OR line MATCHES "^label,")
+    continue()
+  endif()
+  string(REPLACE "," ";" fields "${line}")
+  list(GET fields 0 label)
+  list(GET fields 4 vector_width)
+  if(label MATCHES "_c?[fd]x([0-9]+)_")
+    set(width ${CMAKE_MATCH_1})
+  else()
+    set(width 0)
+  endif()
+  if(NOT vector_width EQUAL width)
+    message(FATAL_ERROR "${label}: vector_width ${vector_width}, expected ${width}")
+  endif()
+  if(width GREATER 1)
+    math(EXPR n_vector "${n_vector} + 1")
+  endif()
+endforeach()
+if(n_vector EQUAL 0)
+  message(FATAL_ERROR "${CSV} has no vector entries")
+endif()
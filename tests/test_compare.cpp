@@ -0,0 +1,58 @@
+// --compare on two runs of the same entries with different repeat counts
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "compare.hpp"
+
+static int n_failed = 0;
+
+// One entry at n_eval 1024 with n_repeat repeats, five samples with a 1 % spread
+static std::string write_run(const std::string &fname, int n_repeat, double Mevals, double max_ulp) {
+    const double eval_time = 1024.0 * n_repeat / Mevals / 1E6;
+    std::ofstream f(fname);
+    f.precision(10);
+    f << "# sleef: 3.5.1\n"
+      << "label,function,library,precision,vector_width,n_eval,n_evals,n_threads,mode,eval_time,Mevals,n_samples,"
+         "t_stddev,max_ulp\n"
+      << "sleef_dx8_exp,exp,sleef,d,8,1024," << 1024 * n_repeat << ",1,throughput," << eval_time << "," << Mevals
+      << ",5," << 0.01 * eval_time << "," << max_ulp << "\n";
+    return fname;
+}
+
+static void expect(const char *what, bool ok) {
+    if (!ok) {
+        std::cerr << what << "\n";
+        n_failed++;
+    }
+}
+
+int main() {
+    const ResultFile base(write_run("test_compare_a.csv", 1000, 500.0, 1.0));
+    const ResultFile more_repeats(write_run("test_compare_b.csv", 4000, 500.0, 1.0));
+    const ResultFile slower(write_run("test_compare_c.csv", 4000, 400.0, 1.0));
+    const ResultFile less_accurate(write_run("test_compare_d.csv", 4000, 500.0, 3.0));
+
+    const auto &row = [](const ResultFile &file) { return file.rows.begin()->second; };
+    expect("files with different repeat counts don't share their key",
+           base.rows.size() == 1 && more_repeats.rows.count(base.rows.begin()->first));
+
+    const ResultChange same(row(base), row(more_repeats), 0.05, 1.0);
+    expect("same Mevals/s at four times the repeats is a change", std::abs(same.change) < 1E-9 && !same.slower);
+    const ResultChange drop(row(base), row(slower), 0.05, 1.0);
+    expect("20% fewer Mevals/s is not -20%", std::abs(drop.change + 0.2) < 1E-9 && drop.slower);
+    expect("a 1 % spread of five samples each is not a +-2 % interval",
+           same.half_width && *same.half_width > 0.01 && *same.half_width < 0.03);
+
+    std::ostringstream os;
+    expect("compare_results flags an unchanged entry", compare_results(os, base, more_repeats, 0.05, 1.0) == 0);
+    expect("compare_results misses the slower entry", compare_results(os, base, slower, 0.05, 1.0) == 1);
+    expect("compare_results misses the ULP increase", compare_results(os, base, less_accurate, 0.05, 1.0) == 1);
+
+    for (const char *fname : {"test_compare_a.csv", "test_compare_b.csv", "test_compare_c.csv", "test_compare_d.csv"})
+        std::remove(fname);
+    return n_failed ? 1 : 0;
+}
@@ -0,0 +1,67 @@
+// EntrySpec against the prefixes the registry uses
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "entry_spec.hpp"
+
+static int n_failed = 0;
+
+static void expect(const std::string &prefix, const std::string &library, const std::string &precision, int width) {
+    const EntrySpec spec(prefix);
+    if (spec.library != library || spec.precision != precision || spec.width != width) {
+        std::cerr << prefix << ": got " << spec.library << ", " << spec.precision << ", " << spec.width << "\n";
+        n_failed++;
+    }
+}
+
+static void expect_invalid(const std::string &prefix) {
+    try {
+        EntrySpec spec(prefix);
+        std::cerr << prefix << ": accepted, width " << spec.width << "\n";
+        n_failed++;
+    } catch (const std::invalid_argument &) {
+    }
+}
+
+int main() {
+    expect("sleef_fx8", "sleef", "f", 8);
+    expect("sleef_dx1", "sleef", "d", 1);
+    expect("agnerfog_fx16", "agnerfog", "f", 16);
+    expect("std_cdx1", "std", "cd", 1);
+    expect("gsl_cdx1", "gsl", "cd", 1);
+    expect("hank10x_soa_cdx8", "hank10x_soa", "cd", 8);
+    expect("eigen_dxx", "eigen", "d", 0);
+    expect("sctl-inline_dx8", "sctl-inline", "d", 8);
+    expect("baobzi-simd-bucketed_dx4", "baobzi-simd-bucketed", "d", 4);
+
+    // The vector_width column of the CSV and JSON output is EntrySpec::width: every vector family of the ISA tiers
+    // has to come out with its lane count
+    for (const auto &[prefix, width] : std::vector<std::pair<std::string, int>>{{"sleef_fx16", 16},
+                                                                                  {"sctl_dx2", 2},
+                                                                                  {"amdlibm_dx8", 8},
+                                                                                  {"roofline_fx4", 4},
+                                                                                  {"remez-rational_dx4", 4},
+                                                                                  {"sleef-refined_dx8", 8},
+                                                                                  {"hank10x-inline_dx1", 1}}) {
+        const EntrySpec spec(prefix);
+        if (spec.width != width) {
+            std::cerr << prefix << ": vector_width " << spec.width << ", expected " << width << "\n";
+            n_failed++;
+        }
+    }
+
+    const EntrySpec mixed("sleef-mixed_dx8");
+    if (mixed.base_library() != "sleef" || mixed.variant() != "mixed") {
+        std::cerr << "sleef-mixed_dx8: got base " << mixed.base_library() << ", variant " << mixed.variant() << "\n";
+        n_failed++;
+    }
+
+    for (const char *prefix :
+         {"sleef", "sleef_", "sleef_dx", "sleef_d8", "sleef_qx8", "sleef_dx0", "sleef_dx8a", "_dx8"})
+        expect_invalid(prefix);
+
+    return n_failed ? 1 : 0;
+}